@@ -16,6 +16,11 @@ namespace orcs {
 
     public:
 
+        /**
+         * Destructor.
+         */
+        virtual ~Algorithm() = default;
+
         /**
          * This method implements the algorithm for solving the problem.
          *
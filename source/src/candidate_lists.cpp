@@ -0,0 +1,47 @@
+#include "candidate_lists.h"
+
+#include <algorithm>
+#include <tuple>
+
+
+orcs::CandidateLists::CandidateLists(const Problem& problem, int k) :
+        n(problem.n),
+        k(0) {
+
+    // Candidate switches (the origin and the manual switches)
+    std::vector<int> eligible(1, 0);
+    for (int i = 1; i <= problem.n; ++i) {
+        if (problem.technology[i] == Technology::MANUAL) {
+            eligible.push_back(i);
+        }
+    }
+
+    // A switch is not a candidate of itself
+    this->k = std::max(0, std::min(k, static_cast<int>(eligible.size()) - 1));
+    candidates.resize(static_cast<std::size_t>(problem.m + 1) * (n + 1) * this->k, 0);
+
+    std::vector< std::tuple<double, int> > distances;
+    distances.reserve(eligible.size());
+
+    for (int l = 1; l <= problem.m && this->k > 0; ++l) {
+        for (int j = 1; j <= problem.n; ++j) {
+
+            distances.clear();
+            for (int i : eligible) {
+                if (i == 0) {
+                    distances.emplace_back(problem.c(0, j, l), 0);
+                } else if (i != j) {
+                    distances.emplace_back(std::min(problem.c(i, j, l), problem.c(j, i, l)), i);
+                }
+            }
+
+            // Keep the k nearest ones (ties are broken by the index of the switch)
+            std::partial_sort(distances.begin(), distances.begin() + this->k, distances.end());
+
+            int* list = candidates.data() + (static_cast<std::size_t>(l) * (n + 1) + j) * this->k;
+            for (int r = 0; r < this->k; ++r) {
+                list[r] = std::get<1>(distances[r]);
+            }
+        }
+    }
+}
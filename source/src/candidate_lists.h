@@ -0,0 +1,60 @@
+#ifndef MANEUVERS_SCHEDULING_CANDIDATE_LISTS_H
+#define MANEUVERS_SCHEDULING_CANDIDATE_LISTS_H
+
+#include <vector>
+
+#include "problem.h"
+
+
+namespace orcs {
+
+    /**
+     * Candidate lists of the granular neighborhoods. For each switch j and each
+     * team l (from 1 to m), it keeps the k switches nearest to j according to the
+     * travel times of team l, in which the distance between switches i and j is
+     * min(c(i,j,l), c(j,i,l)). The origin of the teams (switch 0) is a candidate
+     * as well, at distance c(0,j,l). Only manual switches are candidates, since
+     * remote switches are not assigned to teams 1 to m.
+     */
+    class CandidateLists {
+
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param   problem
+         *          Instance of the problem.
+         * @param   k
+         *          Number of candidates of each switch (it is reduced to the
+         *          number of candidates available, if larger).
+         */
+        CandidateLists(const Problem& problem, int k);
+
+        /**
+         * Return the number of candidates of each switch.
+         */
+        inline int size() const {
+            return k;
+        }
+
+        /**
+         * Return the candidates of switch j for team l, sorted from the nearest
+         * to the farthest (an array of size() switches).
+         */
+        inline const int* nearest(int j, int l) const {
+            return candidates.data() + (static_cast<std::size_t>(l) * (n + 1) + j) * k;
+        }
+
+    private:
+
+        int n;
+        int k;
+        std::vector<int> candidates;
+
+    };
+
+}
+
+
+#endif
@@ -0,0 +1,21 @@
+#include "deadline.h"
+
+
+orcs::Deadline::Deadline(double time_limit) :
+        start(std::chrono::steady_clock::now()),
+        time_limit(time_limit),
+        cancelled(false) {
+
+}
+
+void orcs::Deadline::cancel() {
+    cancelled.store(true, std::memory_order_relaxed);
+}
+
+bool orcs::Deadline::expired() const {
+    return cancelled.load(std::memory_order_relaxed) || elapsed() >= time_limit;
+}
+
+double orcs::Deadline::elapsed() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
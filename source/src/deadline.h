@@ -0,0 +1,60 @@
+#ifndef MANEUVERS_SCHEDULING_DEADLINE_H
+#define MANEUVERS_SCHEDULING_DEADLINE_H
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+
+
+namespace orcs {
+
+    /**
+     * Deadline of an optimization process, which expires when a time limit is
+     * reached or when it is cancelled (e.g., by another thread). It is polled by
+     * the local search and by the neighborhoods inside their loops, so they return
+     * the best solution found so far shortly after the deadline expires. Polling
+     * and cancelling do not lock, so a deadline can be shared by several threads.
+     */
+    class Deadline {
+
+    public:
+
+        /**
+         * Constructor. The time is counted from the construction of the deadline.
+         *
+         * @param   time_limit
+         *          The time limit (in seconds). If not given, the deadline only
+         *          expires when cancelled.
+         */
+        explicit Deadline(double time_limit = std::numeric_limits<double>::max());
+
+        Deadline(const Deadline&) = delete;
+        Deadline& operator=(const Deadline&) = delete;
+
+        /**
+         * Cancel the optimization process (the deadline expires immediately).
+         */
+        void cancel();
+
+        /**
+         * Check whether the deadline has expired.
+         */
+        bool expired() const;
+
+        /**
+         * Return the time elapsed since the construction of the deadline (in seconds).
+         */
+        double elapsed() const;
+
+    private:
+
+        std::chrono::steady_clock::time_point start;
+        double time_limit;
+        std::atomic<bool> cancelled;
+
+    };
+
+}
+
+
+#endif
@@ -0,0 +1,64 @@
+#include "dont_look_bits.h"
+
+#include <algorithm>
+
+
+orcs::DontLookBits::DontLookBits(int n, int layers) :
+        is_enabled(false),
+        stride(n + 1),
+        layers(layers),
+        active(static_cast<std::size_t>(layers) * (n + 1), 1),
+        predecessor(n + 1, 0),
+        successor(n + 1, 0) {
+
+}
+
+void orcs::DontLookBits::enable(bool enabled) {
+    is_enabled = enabled;
+    activate_all();
+}
+
+void orcs::DontLookBits::activate_all() {
+    std::fill(active.begin(), active.end(), 1);
+}
+
+void orcs::DontLookBits::deactivate_all() {
+    std::fill(active.begin(), active.end(), 0);
+}
+
+void orcs::DontLookBits::deactivate(int layer) {
+    std::fill(active.begin() + layer * stride, active.begin() + (layer + 1) * stride, 0);
+}
+
+void orcs::DontLookBits::activate_changes(const Schedule& before, const Schedule& after) {
+
+    // Nothing to do if disabled (all switches are active)
+    if (!is_enabled) {
+        return;
+    }
+
+    // The first (last) switch of team l has -(l+1) as predecessor (successor), so a
+    // change of team is detected as well
+    for (int l = 0; l < static_cast<int>(before.size()); ++l) {
+        int size = static_cast<int>(before[l].size());
+        for (int idx = 0; idx < size; ++idx) {
+            int j = std::get<ATTR_SWITCH>(before[l][idx]);
+            predecessor[j] = (idx > 0 ? std::get<ATTR_SWITCH>(before[l][idx - 1]) : -(l + 1));
+            successor[j] = (idx + 1 < size ? std::get<ATTR_SWITCH>(before[l][idx + 1]) : -(l + 1));
+        }
+    }
+
+    for (int l = 0; l < static_cast<int>(after.size()); ++l) {
+        int size = static_cast<int>(after[l].size());
+        for (int idx = 0; idx < size; ++idx) {
+            int j = std::get<ATTR_SWITCH>(after[l][idx]);
+            int i = (idx > 0 ? std::get<ATTR_SWITCH>(after[l][idx - 1]) : -(l + 1));
+            int k = (idx + 1 < size ? std::get<ATTR_SWITCH>(after[l][idx + 1]) : -(l + 1));
+            if (i != predecessor[j] || k != successor[j]) {
+                for (int layer = 0; layer < layers; ++layer) {
+                    active[layer * stride + j] = 1;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,105 @@
+#ifndef MANEUVERS_SCHEDULING_DONT_LOOK_BITS_H
+#define MANEUVERS_SCHEDULING_DONT_LOOK_BITS_H
+
+#include <vector>
+
+#include "problem.h"
+
+
+namespace orcs {
+
+    /**
+     * Don't-look bits of the switches. When enabled, the local search only examines
+     * moves that involve active switches, i.e., switches whose neighbors in the
+     * sequence of their team have changed (e.g., by a perturbation or by an improving
+     * move) since all their moves were last examined without finding an improvement.
+     * The bits are kept in layers (e.g., one per type of move), so a switch becomes
+     * inactive in a layer without affecting the others. When disabled, all switches
+     * are active.
+     */
+    class DontLookBits {
+
+    public:
+
+        /**
+         * Constructor. The bits are created disabled.
+         *
+         * @param   n
+         *          The number of switches.
+         * @param   layers
+         *          The number of layers of bits.
+         */
+        DontLookBits(int n, int layers = 1);
+
+        /**
+         * Enable or disable the bits. When enabled, all switches become active.
+         */
+        void enable(bool enabled);
+
+        /**
+         * Check whether the bits are enabled.
+         */
+        inline bool enabled() const {
+            return is_enabled;
+        }
+
+        /**
+         * Check whether switch j is active in the given layer.
+         */
+        inline bool is_active(int layer, int j) const {
+            return !is_enabled || active[layer * stride + j];
+        }
+
+        /**
+         * Make all switches active.
+         */
+        void activate_all();
+
+        /**
+         * Make all switches inactive in all layers (e.g., a local optimum has been
+         * reached).
+         */
+        void deactivate_all();
+
+        /**
+         * Make all switches inactive in the given layer (e.g., all moves of a type
+         * have been examined without finding an improvement).
+         */
+        void deactivate(int layer);
+
+        /**
+         * Make switch j inactive in the given layer.
+         */
+        inline void deactivate(int layer, int j) {
+            active[layer * stride + j] = 0;
+        }
+
+        /**
+         * Make active (in all layers) the switches whose team, predecessor or
+         * successor in the sequence of their team differs between two schedules.
+         * It has no effect if the bits are disabled.
+         *
+         * @param   before
+         *          A schedule.
+         * @param   after
+         *          The schedule obtained by changing the first one.
+         */
+        void activate_changes(const Schedule& before, const Schedule& after);
+
+    private:
+
+        bool is_enabled;
+        int stride;
+        int layers;
+        std::vector<char> active;
+
+        // Predecessor and successor of each switch in the first schedule compared
+        std::vector<int> predecessor;
+        std::vector<int> successor;
+
+    };
+
+}
+
+
+#endif
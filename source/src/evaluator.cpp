@@ -0,0 +1,359 @@
+#include "evaluator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+template <>
+orcs::DeltaEvaluator::TimingState<double>& orcs::DeltaEvaluator::state<double>() {
+    return real_state;
+}
+
+template <>
+orcs::DeltaEvaluator::TimingState<std::int32_t>& orcs::DeltaEvaluator::state<std::int32_t>() {
+    return integer_state;
+}
+
+orcs::DeltaEvaluator::DeltaEvaluator(const Problem& problem) :
+        problem(&problem),
+        team(problem.n + 1, -1),
+        position(problem.n + 1, -1),
+        feasible(false),
+        critical(problem.n + 1, 0),
+        stamp(0),
+        dirty(problem.n + 1, 0),
+        affected_team(problem.n + 1, -1),
+        affected_position(problem.n + 1, -1),
+        pendings(problem.n + 1, 0) {
+
+    // Only the timing state of the time type of the instance is used
+    if (problem.integer_times) {
+        integer_state.moment.resize(problem.n + 1, 0);
+        integer_state.updated.resize(problem.n + 1, 0);
+    } else {
+        real_state.moment.resize(problem.n + 1, 0.0);
+        real_state.updated.resize(problem.n + 1, 0.0);
+    }
+
+    order.reserve(problem.n);
+    affected.reserve(problem.n);
+    ready.reserve(problem.n);
+}
+
+bool orcs::DeltaEvaluator::load(const std::tuple<Schedule, double>& entry) {
+
+    base_schedule.assign(std::get<Schedule>(entry));
+    return (problem->integer_times ? load<std::int32_t>() : load<double>());
+}
+
+template <class T>
+bool orcs::DeltaEvaluator::load() {
+
+    TimingState<T>& timing = state<T>();
+
+    // Compute the moments of all switches (all of them are affected)
+    ++stamp;
+    affected.clear();
+    for (int l = 0; l <= problem->m; ++l) {
+        mark(base_schedule, l, 0);
+    }
+
+    close(base_schedule);
+    bool feasibility = (propagate<T>(base_schedule, std::numeric_limits<double>::max()) == EvaluationStatus::FEASIBLE);
+    feasible = feasibility;
+
+    // Store the timing state of the base schedule
+    for (auto j : affected) {
+        team[j] = affected_team[j];
+        position[j] = affected_position[j];
+        timing.moment[j] = timing.updated[j];
+        if (feasibility) {
+            base_schedule.moment_at(team[j], position[j]) = timing.moment[j];
+        }
+    }
+
+    // Sort the switches by their completion time (in decreasing order). It is
+    // used to find the makespan of the switches not affected by a change.
+    order = affected;
+    std::sort(order.begin(), order.end(), [this](int a, int b) {
+        return completion<T>(a) > completion<T>(b);
+    });
+
+    // Switches of the base schedule are no longer marked as affected
+    ++stamp;
+
+    return feasibility;
+}
+
+orcs::EvaluationStatus orcs::DeltaEvaluator::evaluate(const FlatSchedule& schedule, double& makespan,
+        int l1, int from1, int l2, int from2, double bound) {
+
+    // Mark the changed suffixes and the switches affected by them
+    ++stamp;
+    affected.clear();
+    mark(schedule, l1, from1);
+    if (l2 >= 0 && l2 != l1) {
+        mark(schedule, l2, from2);
+    }
+
+    close(schedule);
+
+    // Compute the new moments of the affected switches (with exact integer arithmetic,
+    // if the times of the instance are integer values)
+    EvaluationStatus status = (problem->integer_times ?
+            update<std::int32_t>(schedule, makespan, bound) : update<double>(schedule, makespan, bound));
+
+    // If not feasible, makespan is set to infinity
+    if (status == EvaluationStatus::INFEASIBLE) {
+        makespan = std::numeric_limits<double>::max();
+    }
+
+    return status;
+}
+
+void orcs::DeltaEvaluator::store(FlatSchedule& neighbor) {
+    if (problem->integer_times) {
+        store<std::int32_t>(neighbor);
+    } else {
+        store<double>(neighbor);
+    }
+}
+
+void orcs::DeltaEvaluator::find_critical_path() {
+
+    for (auto j : path) {
+        critical[j] = 0;
+    }
+
+    path.clear();
+    if (!feasible || order.empty()) {
+        return;
+    }
+
+    // Go backwards from the switch that completes last
+    int j = order.front();
+    while (j != 0) {
+        path.push_back(j);
+        critical[j] = 1;
+        j = (problem->integer_times ? binding_predecessor<std::int32_t>(j) : binding_predecessor<double>(j));
+    }
+
+    std::reverse(path.begin(), path.end());
+}
+
+template <class T>
+T orcs::DeltaEvaluator::completion(int j) {
+
+    // Switches not scheduled (e.g., in a cycle) have an infinite moment, which must
+    // not overflow when the maneuver time is added
+    TimingState<T>& timing = state<T>();
+    if (timing.moment[j] == std::numeric_limits<T>::max()) {
+        return std::numeric_limits<T>::max();
+    }
+
+    return timing.moment[j] + problem->maneuver_time<T>(j);
+}
+
+template <class T>
+int orcs::DeltaEvaluator::binding_predecessor(int j) {
+
+    TimingState<T>& timing = state<T>();
+    int l = team[j];
+    int idx = position[j];
+
+    // The moments are recomputed with the same expressions used to compute them (see
+    // DeltaEvaluator::propagate), so the binding constraint is met with equality
+    if (l != 0) {
+        int i = (idx > 0 ? base_schedule.switch_at(l, idx - 1) : 0);
+        T t = timing.moment[i] + problem->maneuver_time<T>(i) + problem->travel_time<T>(i, j, l);
+        if (t == timing.moment[j]) {
+            return i;
+        }
+    }
+
+    for (auto k : problem->predecessors_csr[j]) {
+        if (timing.moment[k] + problem->maneuver_time<T>(k) == timing.moment[j]) {
+            return k;
+        }
+    }
+
+    return 0;
+}
+
+template <class T>
+orcs::EvaluationStatus orcs::DeltaEvaluator::update(const FlatSchedule& schedule, double& makespan, double bound) {
+
+    TimingState<T>& timing = state<T>();
+
+    // Makespan of the switches not affected by the change
+    T makespan_unaffected = 0;
+    for (auto j : order) {
+        if (dirty[j] != stamp) {
+            makespan_unaffected = completion<T>(j);
+            break;
+        }
+    }
+
+    // A switch left unscheduled by an infeasible base schedule dominates any bound
+    if (makespan_unaffected == std::numeric_limits<T>::max() || makespan_unaffected >= bound) {
+        return EvaluationStatus::DOMINATED;
+    }
+
+    // Compute the new moments of the affected switches
+    EvaluationStatus status = propagate<T>(schedule, bound);
+    if (status != EvaluationStatus::FEASIBLE) {
+        return status;
+    }
+
+    // Compute the makespan
+    T makespan_neighbor = makespan_unaffected;
+    for (auto j : affected) {
+        makespan_neighbor = std::max(makespan_neighbor, timing.updated[j] + problem->maneuver_time<T>(j));
+    }
+
+    makespan = makespan_neighbor;
+    return EvaluationStatus::FEASIBLE;
+}
+
+template <class T>
+void orcs::DeltaEvaluator::store(FlatSchedule& schedule) {
+    TimingState<T>& timing = state<T>();
+    for (auto j : affected) {
+        schedule.moment_at(affected_team[j], affected_position[j]) = timing.updated[j];
+    }
+}
+
+void orcs::DeltaEvaluator::mark(const FlatSchedule& schedule, int l, int from) {
+    for (int idx = from; idx < schedule.size(l); ++idx) {
+        int j = schedule.switch_at(l, idx);
+        dirty[j] = stamp;
+        affected_team[j] = l;
+        affected_position[j] = idx;
+        affected.push_back(j);
+    }
+}
+
+void orcs::DeltaEvaluator::close(const FlatSchedule& schedule) {
+
+    // Close the set of affected switches under team and precedence successors. Switches
+    // not marked yet are not in a changed suffix, so their base position is still valid.
+    for (std::size_t k = 0; k < affected.size(); ++k) {
+
+        int j = affected[k];
+        int l = affected_team[j];
+        int idx = affected_position[j];
+
+        if (idx + 1 < schedule.size(l)) {
+            int s = schedule.switch_at(l, idx + 1);
+            if (dirty[s] != stamp) {
+                dirty[s] = stamp;
+                affected_team[s] = l;
+                affected_position[s] = idx + 1;
+                affected.push_back(s);
+            }
+        }
+
+        for (auto s : problem->successors_csr[j]) {
+            if (dirty[s] != stamp) {
+                dirty[s] = stamp;
+                affected_team[s] = team[s];
+                affected_position[s] = position[s];
+                affected.push_back(s);
+            }
+        }
+    }
+}
+
+template <class T>
+orcs::EvaluationStatus orcs::DeltaEvaluator::propagate(const FlatSchedule& schedule, double bound) {
+
+    TimingState<T>& timing = state<T>();
+
+    // Count the pending (affected) predecessors of each affected switch
+    for (auto j : affected) {
+        pendings[j] = 0;
+        timing.updated[j] = std::numeric_limits<T>::max();
+    }
+
+    for (auto j : affected) {
+        int l = affected_team[j];
+        int idx = affected_position[j];
+        if (idx + 1 < schedule.size(l)) {
+            ++pendings[schedule.switch_at(l, idx + 1)];
+        }
+        for (auto s : problem->successors_csr[j]) {
+            ++pendings[s];
+        }
+    }
+
+    // Compute the moments of the affected switches in topological order
+    ready.clear();
+    for (auto j : affected) {
+        if (pendings[j] == 0) {
+            ready.push_back(j);
+        }
+    }
+
+    auto time = [this, &timing](int i) {
+        return (dirty[i] == stamp ? timing.updated[i] : timing.moment[i]);
+    };
+
+    for (std::size_t head = 0; head < ready.size(); ++head) {
+
+        int j = ready[head];
+        int l = affected_team[j];
+        int idx = affected_position[j];
+
+        // Compute the operation moment
+        T t = 0;
+        if (l != 0) {
+            int i = (idx > 0 ? schedule.switch_at(l, idx - 1) : 0);
+            t = time(i) + problem->maneuver_time<T>(i) + problem->travel_time<T>(i, j, l);
+        }
+
+        // Check the precedence constraints
+        for (auto k : problem->predecessors_csr[j]) {
+            t = std::max(t, time(k) + problem->maneuver_time<T>(k));
+        }
+
+        timing.updated[j] = t;
+
+        // Abort if the completion time reaches the bound
+        if (t + problem->maneuver_time<T>(j) >= bound) {
+            return EvaluationStatus::DOMINATED;
+        }
+
+        // Update the pending counters
+        if (idx + 1 < schedule.size(l)) {
+            int s = schedule.switch_at(l, idx + 1);
+            if (--pendings[s] == 0) {
+                ready.push_back(s);
+            }
+        }
+
+        for (auto s : problem->successors_csr[j]) {
+            if (--pendings[s] == 0) {
+                ready.push_back(s);
+            }
+        }
+    }
+
+    // All affected switches must have been scheduled (otherwise, there is a deadlock)
+    return (ready.size() == affected.size() ? EvaluationStatus::FEASIBLE : EvaluationStatus::INFEASIBLE);
+}
+
+orcs::EvaluationContext::EvaluationContext(const Problem& problem) :
+        team(problem.n + 1, 0),
+        position(problem.n + 1, 0),
+        pendings(problem.n + 1, 0) {
+
+    // Only the moments of the time type of the instance are used
+    if (problem.integer_times) {
+        integer_moment.resize(problem.n + 1, 0);
+    } else {
+        real_moment.resize(problem.n + 1, 0.0);
+    }
+
+    ready.reserve(problem.n);
+}
@@ -0,0 +1,232 @@
+#ifndef MANEUVERS_SCHEDULING_EVALUATOR_H
+#define MANEUVERS_SCHEDULING_EVALUATOR_H
+
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+#include "flat_schedule.h"
+#include "problem.h"
+
+
+namespace orcs {
+
+    /**
+     * Result of the evaluation of a schedule. A schedule is dominated if its
+     * evaluation has been aborted because the makespan certainly reaches a given
+     * upper bound (e.g., the makespan of the incumbent solution).
+     */
+    enum class EvaluationStatus {
+        FEASIBLE,
+        INFEASIBLE,
+        DOMINATED
+    };
+
+    /**
+     * Incremental (delta) evaluation engine for schedules. The evaluator keeps
+     * the timing state (team, position and moment of each switch) of a base
+     * schedule. A neighbor of the base schedule, obtained by changing the
+     * sequences of at most two teams, is evaluated by recomputing only the
+     * moments of the switches in the changed suffixes of those teams and of
+     * the switches that (directly or indirectly) depend on them, i.e., their
+     * team and precedence successors. The moments of all other switches are
+     * taken from the base schedule. Neighbors are handled as flat schedules,
+     * so they can be built from a copy of the base schedule without allocating
+     * memory. If the times of the instance are integer values, the moments are
+     * computed with exact integer arithmetic (see Problem::integer_times).
+     */
+    class DeltaEvaluator {
+
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param   problem
+         *          The instance of the problem the schedules belong to.
+         */
+        explicit DeltaEvaluator(const Problem& problem);
+
+        /**
+         * Load a base schedule. The moments of the switches are (re)computed
+         * from the sequences of the teams, so the moments stored in the entry
+         * are not required to be up to date.
+         *
+         * @param   entry
+         *          The base schedule.
+         * @return  True if the base schedule is feasible, false otherwise.
+         */
+        bool load(const std::tuple<Schedule, double>& entry);
+
+        /**
+         * Return the base schedule as a flat schedule, with the moments computed by
+         * the last call to load.
+         */
+        inline const FlatSchedule& base() const {
+            return base_schedule;
+        }
+
+        /**
+         * Evaluate a neighbor of the base schedule. The neighbor must differ from the
+         * base schedule only in the sequences of teams l1 and l2, from positions from1
+         * and from2 onwards, respectively. The moments stored in the neighbor are
+         * neither read nor changed (see DeltaEvaluator::store).
+         *
+         * @param   neighbor
+         *          The neighbor to evaluate.
+         * @param   makespan
+         *          The makespan of the neighbor (updated only if it is FEASIBLE or
+         *          INFEASIBLE, in which case it is set to infinity).
+         * @param   l1
+         *          A team whose sequence has changed.
+         * @param   from1
+         *          The first position of the sequence of team l1 that has changed.
+         * @param   l2
+         *          Another team whose sequence has changed (-1, if none).
+         * @param   from2
+         *          The first position of the sequence of team l2 that has changed.
+         * @param   bound
+         *          Upper bound on the makespan. The evaluation is aborted as soon as
+         *          the completion time of a switch reaches it.
+         * @return  FEASIBLE if the neighbor is feasible and its makespan is lower than
+         *          the bound, DOMINATED if its makespan certainly reaches the bound or
+         *          INFEASIBLE otherwise.
+         */
+        EvaluationStatus evaluate(const FlatSchedule& neighbor, double& makespan, int l1, int from1,
+                int l2 = -1, int from2 = -1, double bound = std::numeric_limits<double>::max());
+
+        /**
+         * Write the moments computed by the last evaluation, which must be FEASIBLE,
+         * into the neighbor evaluated. The moments of the switches not affected by the
+         * changes must be equal to the ones in the base schedule (e.g., the neighbor is
+         * a modified copy of DeltaEvaluator::base).
+         *
+         * @param   neighbor
+         *          The neighbor evaluated.
+         */
+        void store(FlatSchedule& neighbor);
+
+        /**
+         * Find a critical path of the base schedule, i.e., a chain of switches that
+         * determines its makespan. It starts at a switch whose completion time is
+         * the makespan and goes backwards through the constraints that set the
+         * moments of the switches (the travel from the previous switch of the team
+         * or the completion of a precedence predecessor), until a switch whose moment
+         * is set by the travel from the origin. Only moves that change the critical
+         * path can reduce the makespan. The base schedule must be feasible.
+         */
+        void find_critical_path();
+
+        /**
+         * Return the critical path found by the last call to find_critical_path, from
+         * its first to its last switch.
+         */
+        inline const std::vector<int>& critical_path() const {
+            return path;
+        }
+
+        /**
+         * Check whether switch j is in the critical path found by the last call to
+         * find_critical_path.
+         */
+        inline bool is_critical(int j) const {
+            return critical[j];
+        }
+
+    private:
+
+        // Moments of the switches in the base schedule and in the neighbor being
+        // evaluated, in the time type T of the instance
+        template <class T>
+        struct TimingState {
+            std::vector<T> moment;
+            std::vector<T> updated;
+        };
+
+        template <class T>
+        TimingState<T>& state();
+
+        template <class T>
+        bool load();
+
+        template <class T>
+        EvaluationStatus update(const FlatSchedule& schedule, double& makespan, double bound);
+
+        template <class T>
+        void store(FlatSchedule& schedule);
+
+        void mark(const FlatSchedule& schedule, int l, int from);
+
+        void close(const FlatSchedule& schedule);
+
+        template <class T>
+        EvaluationStatus propagate(const FlatSchedule& schedule, double bound);
+
+        template <class T>
+        T completion(int j);
+
+        template <class T>
+        int binding_predecessor(int j);
+
+        const Problem* problem;
+
+        // Timing state of the base schedule
+        FlatSchedule base_schedule;
+        std::vector<int> team;
+        std::vector<int> position;
+        std::vector<int> order;
+        TimingState<double> real_state;
+        TimingState<std::int32_t> integer_state;
+
+        // Feasibility and critical path of the base schedule
+        bool feasible;
+        std::vector<int> path;
+        std::vector<char> critical;
+
+        // Workspace of the incremental evaluation
+        long stamp;
+        std::vector<long> dirty;
+        std::vector<int> affected;
+        std::vector<int> affected_team;
+        std::vector<int> affected_position;
+        std::vector<int> pendings;
+        std::vector<int> ready;
+
+    };
+
+    /**
+     * Workspace of the full evaluation of schedules (utils::evaluate), so its data
+     * structures are allocated only once per problem instead of once per
+     * evaluation. A context must not be shared among threads, i.e., each thread
+     * must own its context.
+     */
+    class EvaluationContext {
+
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param   problem
+         *          The instance of the problem the schedules belong to.
+         */
+        explicit EvaluationContext(const Problem& problem);
+
+        // Team and position of each switch, number of pending predecessors and switches
+        // ready to be processed
+        std::vector<int> team;
+        std::vector<int> position;
+        std::vector<int> pendings;
+        std::vector<int> ready;
+
+        // Moments (fixed) of the switches, in the time type of the instance
+        std::vector<double> real_moment;
+        std::vector<std::int32_t> integer_moment;
+
+    };
+
+}
+
+
+#endif
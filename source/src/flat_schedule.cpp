@@ -0,0 +1,85 @@
+#include "flat_schedule.h"
+
+#include <algorithm>
+
+
+orcs::FlatSchedule::FlatSchedule(const Schedule& schedule) {
+    assign(schedule);
+}
+
+void orcs::FlatSchedule::assign(const Schedule& schedule) {
+
+    switches.clear();
+    moments.clear();
+    offset.resize(schedule.size() + 1);
+
+    for (int l = 0; l < static_cast<int>(schedule.size()); ++l) {
+        offset[l] = switches.size();
+        for (const auto& maneuver : schedule[l]) {
+            switches.push_back(std::get<ATTR_SWITCH>(maneuver));
+            moments.push_back(std::get<ATTR_MOMENT>(maneuver));
+        }
+    }
+
+    offset[schedule.size()] = switches.size();
+}
+
+orcs::Schedule orcs::FlatSchedule::to_schedule() const {
+
+    Schedule schedule = create_empty_schedule(static_cast<int>(offset.size()) - 2);
+    for (int l = 0; l + 1 < static_cast<int>(offset.size()); ++l) {
+        schedule[l].reserve(size(l));
+        for (int k = offset[l]; k < offset[l + 1]; ++k) {
+            schedule[l].emplace_back(switches[k], moments[k]);
+        }
+    }
+
+    return schedule;
+}
+
+void orcs::FlatSchedule::move(int l_origin, int idx_origin, int length, int l_target, int idx_target) {
+
+    // Position of the segment and of its insertion point (after the removal of the
+    // segment) in the giant tour
+    int first = offset[l_origin] + idx_origin;
+    int last = first + length;
+    int target = offset[l_target] + idx_target - (l_target > l_origin ? length : 0);
+
+    // Rotate the switches between the segment and its insertion point
+    if (target < first) {
+        std::rotate(switches.begin() + target, switches.begin() + first, switches.begin() + last);
+        std::rotate(moments.begin() + target, moments.begin() + first, moments.begin() + last);
+    } else if (target > first) {
+        std::rotate(switches.begin() + first, switches.begin() + last, switches.begin() + target + length);
+        std::rotate(moments.begin() + first, moments.begin() + last, moments.begin() + target + length);
+    }
+
+    // Update the first position of the teams between origin and target
+    for (int l = l_origin + 1; l <= l_target; ++l) {
+        offset[l] -= length;
+    }
+
+    for (int l = l_target + 1; l <= l_origin; ++l) {
+        offset[l] += length;
+    }
+}
+
+void orcs::FlatSchedule::exchange(int l1, int idx1, int target1, int l2, int idx2, int target2) {
+
+    // Move the first switch to team l2. The position target1 refers to the sequence
+    // without the second switch, which is still there.
+    move(l1, idx1, 1, l2, (target1 <= idx2 ? target1 : target1 + 1));
+
+    // Move the second switch to team l1 (which no longer has the first switch)
+    move(l2, (target1 <= idx2 ? idx2 + 1 : idx2), 1, l1, target2);
+}
+
+void orcs::FlatSchedule::exchange_tails(int l1, int idx1, int l2, int idx2) {
+
+    // Append the tail of team l1 to team l2, then move the tail of team l2 (which is
+    // before the appended one) to team l1
+    int length1 = size(l1) - idx1;
+    int length2 = size(l2) - idx2;
+    move(l1, idx1, length1, l2, size(l2));
+    move(l2, idx2, length2, l1, idx1);
+}
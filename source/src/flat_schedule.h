@@ -0,0 +1,123 @@
+#ifndef MANEUVERS_SCHEDULING_FLAT_SCHEDULE_H
+#define MANEUVERS_SCHEDULING_FLAT_SCHEDULE_H
+
+#include <vector>
+
+#include "problem.h"
+
+
+namespace orcs {
+
+    /**
+     * A solution for the problem encoded as a giant tour: the sequences of all
+     * teams (from 0 to m) are stored one after the other in a single array of
+     * switches, and the sequence of team l occupies positions offset[l] to
+     * offset[l+1]-1. The moments of the maneuvers are stored in a parallel
+     * array. Copying a flat schedule into another one of the same instance does
+     * not allocate memory, and switches are moved around by rotating segments
+     * of the arrays in place.
+     */
+    class FlatSchedule {
+
+    public:
+
+        /**
+         * Constructor. Creates an empty flat schedule.
+         */
+        FlatSchedule() = default;
+
+        /**
+         * Constructor. Creates a flat schedule from a schedule.
+         *
+         * @param   schedule
+         *          The schedule to convert.
+         */
+        explicit FlatSchedule(const Schedule& schedule);
+
+        /**
+         * Overwrite this flat schedule with the content of a schedule. The memory
+         * already allocated is reused.
+         *
+         * @param   schedule
+         *          The schedule to convert.
+         */
+        void assign(const Schedule& schedule);
+
+        /**
+         * Convert this flat schedule into a schedule.
+         *
+         * @return  The schedule.
+         */
+        Schedule to_schedule() const;
+
+        /**
+         * Return the number of switches in the sequence of team l.
+         */
+        inline int size(int l) const {
+            return offset[l + 1] - offset[l];
+        }
+
+        /**
+         * Return the switch at position idx of the sequence of team l.
+         */
+        inline int switch_at(int l, int idx) const {
+            return switches[offset[l] + idx];
+        }
+
+        /**
+         * Return the moment of the maneuver at position idx of the sequence of team l.
+         */
+        inline double& moment_at(int l, int idx) {
+            return moments[offset[l] + idx];
+        }
+
+        inline double moment_at(int l, int idx) const {
+            return moments[offset[l] + idx];
+        }
+
+        /**
+         * Move a segment of the sequence of a team to a position of the sequence of
+         * (possibly) another team. The segment keeps its order.
+         *
+         * @param   l_origin
+         *          The team the segment is taken from.
+         * @param   idx_origin
+         *          The position of the first switch of the segment.
+         * @param   length
+         *          The number of switches of the segment.
+         * @param   l_target
+         *          The team the segment is moved to.
+         * @param   idx_target
+         *          The position of the sequence of team l_target (after the removal
+         *          of the segment) in which the segment is inserted.
+         */
+        void move(int l_origin, int idx_origin, int length, int l_target, int idx_target);
+
+        /**
+         * Exchange the switches at position idx1 of team l1 and at position idx2 of
+         * team l2 (l1 != l2). The switch of team l1 is inserted at position target1
+         * of team l2 and the switch of team l2 is inserted at position target2 of team
+         * l1 (positions refer to the sequences without the exchanged switches).
+         */
+        void exchange(int l1, int idx1, int target1, int l2, int idx2, int target2);
+
+        /**
+         * Exchange the tails of the sequences of teams l1 and l2 (l1 != l2), i.e., the
+         * switches of team l1 from position idx1 onwards and the switches of team l2
+         * from position idx2 onwards. Exchanging the tails again from the same
+         * positions restores the sequences.
+         */
+        void exchange_tails(int l1, int idx1, int l2, int idx2);
+
+        // Switches of all teams (giant tour), the position of the first switch of
+        // each team (plus a sentinel) and the moments of the maneuvers
+        std::vector<int> switches;
+        std::vector<int> offset;
+        std::vector<double> moments;
+
+    };
+
+}
+
+
+#endif
@@ -21,7 +21,7 @@ std::tuple<orcs::Schedule, double> orcs::Greedy::solve(const Problem& problem,
     std::vector<int> phi(problem.m + 1, 0);
 
     for (int i = 1; i <= problem.n; ++i) {
-        gamma[i] = problem.predecessors[i].size();
+        gamma[i] = problem.predecessors_csr[i].size();
         if (problem.technology[i] == Technology::MANUAL) {
             S_manual.insert(i);
         } else if (problem.technology[i] == Technology::REMOTE) {
@@ -42,11 +42,11 @@ std::tuple<orcs::Schedule, double> orcs::Greedy::solve(const Problem& problem,
                 if (gamma[*j] == 0) {
 
                     t[*j] = 0;
-                    for (auto i : problem.predecessors[*j]) {
+                    for (auto i : problem.predecessors_csr[*j]) {
                         t[*j] = std::max(t[*j], t[i] + problem.p[i]);
                     }
 
-                    for (auto i : problem.successors[*j]) {
+                    for (auto i : problem.successors_csr[*j]) {
                         --gamma[i];
                     }
 
@@ -70,7 +70,7 @@ std::tuple<orcs::Schedule, double> orcs::Greedy::solve(const Problem& problem,
             for (auto j_trial : S_manual) {
                 if (gamma[j_trial] == 0) {
                     for (int l_trial = 1; l_trial <= problem.m; ++l_trial) {
-                        double criterion_trial = t[phi[l_trial]] + problem.p[phi[l_trial]] + problem.c[phi[l_trial]][j_trial][l_trial];
+                        double criterion_trial = t[phi[l_trial]] + problem.p[phi[l_trial]] + problem.c(phi[l_trial], j_trial, l_trial);
                         if (criterion_trial < criterion) {
                             criterion = criterion_trial;
                             j = j_trial;
@@ -81,13 +81,13 @@ std::tuple<orcs::Schedule, double> orcs::Greedy::solve(const Problem& problem,
             }
 
             // Compute the moment in which the  maneuver will be performed
-            t[j] = t[phi[l]] + problem.p[phi[l]] + problem.c[phi[l]][j][l];
-            for (auto i : problem.predecessors[j]) {
+            t[j] = t[phi[l]] + problem.p[phi[l]] + problem.c(phi[l], j, l);
+            for (auto i : problem.predecessors_csr[j]) {
                 t[j] = std::max(t[j], t[i] + problem.p[i]);
             }
 
             // Update the counter of predecessors not scheduled
-            for (auto i : problem.successors[j]) {
+            for (auto i : problem.successors_csr[j]) {
                 --gamma[i];
             }
 
@@ -1,15 +1,23 @@
 #include "heur_ils.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <limits>
 #include <list>
+#include <mutex>
+#include <string>
+#include <thread>
 
 #include <cxxtimer.hpp>
 
+#include "candidate_lists.h"
+#include "deadline.h"
 #include "heur_greedy.h"
 #include "local_search.h"
 #include "neighborhood.h"
+#include "schedule_hash.h"
+#include "thread_pool.h"
 #include "utils.h"
 
 
@@ -27,21 +35,80 @@ std::tuple<orcs::Schedule, double> orcs::ILS::solve(const Problem& problem,
     const double time_limit = opt_input->get<double>("time-limit", std::numeric_limits<double>::max());
     const long iterations_limit = opt_input->get<long>("iterations-limit", std::numeric_limits<long>::max());
     const long perturbation_passes_limit = opt_input->get<long>("perturbation-passes-limit", 15);
-
-    // Initialize the random number generator
-    std::mt19937 generator;
-    generator.seed(seed);
-
-    // Initialize a timer
+    const int threads = opt_input->get<int>("threads", 1);
+    const int trajectories = std::max(1, opt_input->get<int>("trajectories", 1));
+    const long migration_interval = opt_input->get<long>("migration-interval", 0);
+    const bool migration_complete = (opt_input->get<std::string>("migration-topology", "ring") == "complete");
+    const bool dont_look_bits = opt_input->get<bool>("dont-look-bits", false);
+    const int granularity = opt_input->get<int>("granularity", 0);
+    const bool or_opt = opt_input->get<bool>("or-opt", false);
+    const bool tail_exchange = opt_input->get<bool>("tail-exchange", false);
+    const bool pair_swap = opt_input->get<bool>("pair-swap", false);
+    const bool critical_path = opt_input->get<bool>("critical-path", false);
+    const bool adaptive_vnd = opt_input->get<bool>("adaptive-vnd", false);
+    const long visited_cache = opt_input->get<long>("visited-cache", 0);
+
+    // Initialize a timer and the deadline of the optimization process (it is polled
+    // inside the local search, so the time limit is met even during a long VND)
     cxxtimer::Timer timer;
     timer.start();
+    Deadline deadline(time_limit);
 
-    // Define the list of neigborhoods used by the VND
-    std::list<Neighborhood*> neighborhoods = {
-            new Shift(),
-            new Reassignement(),
-            new Swap()
-    };
+    // Candidate lists of the granular neighborhoods (if any)
+    CandidateLists candidate_lists(problem, granularity);
+    const CandidateLists* candidates = (granularity > 0 ? &candidate_lists : nullptr);
+
+    // Keys of the hashes of the solutions visited (if cached)
+    std::unique_ptr<ScheduleHash> schedule_hash(visited_cache > 0 ? new ScheduleHash(problem) : nullptr);
+
+    // The threads are split among the trajectories, which scan the neighborhoods with
+    // their share of them
+    int threads_available = (threads > 0 ? threads : std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+    int threads_per_trajectory = (trajectories == 1 ? threads : std::max(1, threads_available / trajectories));
+
+    // Each trajectory has its own random number generator (the first one is seeded
+    // with the seed given, so a single trajectory reproduces the sequential ILS), its
+    // own search context and its own neighborhoods (which keep statistics)
+    std::vector<Trajectory> trajectory(trajectories);
+    for (int k = 0; k < trajectories; ++k) {
+
+        if (k == 0) {
+            trajectory[k].generator.seed(seed);
+        } else {
+            std::seed_seq sequence = {seed, static_cast<unsigned>(k)};
+            trajectory[k].generator.seed(sequence);
+        }
+
+        trajectory[k].pool.reset(new ThreadPool(threads_per_trajectory));
+        trajectory[k].context.reset(new SearchContext(problem));
+        trajectory[k].context->set_thread_pool(trajectory[k].pool.get());
+        trajectory[k].context->dont_look.enable(dont_look_bits);
+        trajectory[k].context->deadline = &deadline;
+
+        if (visited_cache > 0) {
+            trajectory[k].visited.reset(new VisitedCache(visited_cache));
+        }
+
+        // Define the list of neigborhoods used by the VND (the in-place pair swaps, if
+        // any, are examined before the full swaps)
+        std::list<std::unique_ptr<Neighborhood>>& neighborhoods = trajectory[k].neighborhoods;
+        neighborhoods.emplace_back(new Shift(critical_path));
+        neighborhoods.emplace_back(new Reassignement(candidates, critical_path));
+
+        if (pair_swap) {
+            neighborhoods.emplace_back(new PairSwap(critical_path));
+        }
+
+        neighborhoods.emplace_back(new Swap(candidates, critical_path));
+
+        if (or_opt) {
+            neighborhoods.emplace_back(new OrOpt());
+        }
+
+        if (tail_exchange) {
+            neighborhoods.emplace_back(new TailExchange());
+        }
+    }
 
     // Log: header
     log_header(verbose);
@@ -55,61 +122,171 @@ std::tuple<orcs::Schedule, double> orcs::ILS::solve(const Problem& problem,
             timer.count<std::chrono::milliseconds>() / 1000.0,
             verbose);
 
-    // Find a local optimum from the start solution
-    std::tuple<Schedule, double> incumbent = LocalSearch::best_improvement_vnd(problem,
-            start, neighborhoods);
+    // Find a local optimum from the start solution, which is the start of all
+    // trajectories (the VND calls are timed)
+    trajectory[0].vnd_timer.start();
+    std::tuple<Schedule, double> local_optimum = (adaptive_vnd ?
+            LocalSearch::adaptive_vnd(problem, start, trajectory[0].neighborhoods, *trajectory[0].context) :
+            LocalSearch::best_improvement_vnd(problem, start, trajectory[0].neighborhoods, *trajectory[0].context));
+    trajectory[0].vnd_timer.stop();
+    trajectory[0].vnd_calls = 1;
 
     // Log the initial solution (after LS)
     log_iteration(0L, std::get<double>(start),
-            std::get<double>(start), std::get<double>(incumbent),
+            std::get<double>(start), std::get<double>(local_optimum),
             timer.count<std::chrono::milliseconds>() / 1000.0,
             verbose);
 
-    // Start the iterative process
-    long iteration = 0;
-    long perturbation_passes = 1;
+    // State shared by the trajectories: the best solution found, the number of
+    // iterations performed by all of them and whether a shared stopping criterion
+    // (time or iterations limit) has been met (in which case the deadline is
+    // cancelled, so the other trajectories stop their local search)
+    std::tuple<Schedule, double> best = local_optimum;
     long iteration_last_improvement = 0;
+    std::mutex mutex;
+    std::atomic<long> iterations(0);
+    std::atomic<bool> stop(false);
 
-    while (iteration < iterations_limit &&
-           timer.count<std::chrono::seconds>() < time_limit &&
-           perturbation_passes <= perturbation_passes_limit) {
+    auto search = [&](int k) {
 
-        // Increment the iteration counter
-        ++iteration;
+        std::mt19937& generator = trajectory[k].generator;
+        SearchContext& context = *trajectory[k].context;
+        std::list<std::unique_ptr<Neighborhood>>& neighborhoods = trajectory[k].neighborhoods;
 
-        // Perturbation phase
-        std::tuple<Schedule, double> perturbed = perturb(problem, incumbent, generator);
-        for (long i = 1; i < perturbation_passes; ++i) {
-            perturbed = perturb(problem, perturbed, generator);
-        }
+        // Start the iterative process
+        std::tuple<Schedule, double> incumbent = local_optimum;
+        long perturbation_passes = 1;
+        long trajectory_iterations = 0;
+        bool published = true;
+
+        while (!stop && perturbation_passes <= perturbation_passes_limit) {
+
+            // Increment the iteration counter (shared by all trajectories)
+            if (deadline.expired() || iterations >= iterations_limit) {
+                stop = true;
+                deadline.cancel();
+                break;
+            }
 
-        // VND as local search method
-        std::tuple<Schedule, double> trial = LocalSearch::best_improvement_vnd(problem,
-                perturbed, neighborhoods);
+            long iteration = ++iterations;
+            if (iteration > iterations_limit) {
+                stop = true;
+                deadline.cancel();
+                break;
+            }
 
-        // Log: status at current iterations
-        log_iteration(iteration, std::get<double>(incumbent),
-                std::get<double>(perturbed), std::get<double>(trial),
-                timer.count<std::chrono::milliseconds>() / 1000.0,
-                verbose);
+            // Perturbation phase
+            std::tuple<Schedule, double> perturbed = perturb(problem, incumbent, context, generator);
+            for (long i = 1; i < perturbation_passes; ++i) {
+                perturbed = perturb(problem, perturbed, context, generator);
+            }
 
-        // Check for improvements
-        if (utils::is_lower(std::get<double>(trial), std::get<double>(incumbent))) {
+            // Switches moved by the perturbation are examined by the VND
+            context.dont_look.activate_changes(std::get<Schedule>(incumbent), std::get<Schedule>(perturbed));
 
-            // Update the incumbent solution
-            incumbent = std::move(trial);
-            iteration_last_improvement = iteration;
+            // Look for the perturbed solution in the cache of visited solutions (if any)
+            const std::tuple<Schedule, double>* visited = nullptr;
+            std::uint64_t perturbed_hash = 0;
+            if (trajectory[k].visited != nullptr) {
+                perturbed_hash = schedule_hash->hash(std::get<Schedule>(perturbed));
+                visited = trajectory[k].visited->find(perturbed_hash, std::get<Schedule>(perturbed));
+            }
 
-            // Reset the perturbation level
-            perturbation_passes = 1;
+            std::tuple<Schedule, double> trial;
+            if (visited != nullptr) {
+
+                // The local optimum found from the perturbed solution is reused
+                trial = *visited;
+                context.dont_look.deactivate_all();
+
+            } else {
+
+                // VND as local search method
+                trajectory[k].vnd_timer.start();
+                trial = (adaptive_vnd ?
+                        LocalSearch::adaptive_vnd(problem, perturbed, neighborhoods, context) :
+                        LocalSearch::best_improvement_vnd(problem, perturbed, neighborhoods, context));
+                trajectory[k].vnd_timer.stop();
+                ++trajectory[k].vnd_calls;
+
+                // Cache the local optimum found from the perturbed solution and from itself
+                // (unless the VND has been interrupted by the deadline)
+                if (trajectory[k].visited != nullptr && !deadline.expired()) {
+                    trajectory[k].visited->insert(perturbed_hash, std::get<Schedule>(perturbed), trial);
+                    trajectory[k].visited->insert(schedule_hash->hash(std::get<Schedule>(trial)),
+                            std::get<Schedule>(trial), trial);
+                }
+            }
 
-        } else {
+            // Log: status at current iterations
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                log_iteration(iteration, std::get<double>(incumbent),
+                        std::get<double>(perturbed), std::get<double>(trial),
+                        timer.count<std::chrono::milliseconds>() / 1000.0,
+                        verbose);
+            }
 
-            // Increase the perturbation level
-            ++perturbation_passes;
+            // Check for improvements
+            if (utils::is_lower(std::get<double>(trial), std::get<double>(incumbent))) {
+
+                // Update the best solution found by all trajectories
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (utils::is_lower(std::get<double>(trial), std::get<double>(best))) {
+                        best = trial;
+                        iteration_last_improvement = iteration;
+                    }
+                }
+
+                // Update the incumbent solution
+                incumbent = std::move(trial);
+                published = false;
+
+                // Reset the perturbation level
+                perturbation_passes = 1;
+
+            } else {
+
+                // Increase the perturbation level
+                ++perturbation_passes;
+            }
+
+            // Migration between trajectories (islands)
+            ++trajectory_iterations;
+            if (trajectories > 1 && migration_interval > 0) {
+
+                // Publish the incumbent solution periodically (if it has changed)
+                if (!published && trajectory_iterations % migration_interval == 0) {
+                    trajectory[k].mailbox.publish(incumbent);
+                    published = true;
+                }
+
+                // Adopt the best solution published by the neighbors, if the trajectory
+                // stagnates and the solution is better than the incumbent one
+                if (perturbation_passes >= perturbation_passes_limit) {
+                    const std::tuple<Schedule, double>* elite = nullptr;
+                    for (int d = 1; d < (migration_complete ? trajectories : 2); ++d) {
+                        const std::tuple<Schedule, double>* other =
+                                trajectory[(k + trajectories - d) % trajectories].mailbox.read();
+                        if (other != nullptr && (elite == nullptr || std::get<double>(*other) < std::get<double>(*elite))) {
+                            elite = other;
+                        }
+                    }
+
+                    if (elite != nullptr && utils::is_lower(std::get<double>(*elite), std::get<double>(incumbent))) {
+                        incumbent = *elite;
+                        perturbation_passes = 1;
+                        ++trajectory[k].migrations;
+                    }
+                }
+            }
         }
+    };
 
-    }
+    // Run the trajectories (a single trajectory runs on the calling thread)
+    ThreadPool trajectory_pool(trajectories);
+    trajectory_pool.run(search);
 
     // Stop timer
     timer.stop();
@@ -119,22 +296,65 @@ std::tuple<orcs::Schedule, double> orcs::ILS::solve(const Problem& problem,
 
     // // Store optional output
     if (opt_output != nullptr) {
-        opt_output->add("Iterations", iteration);
+        opt_output->add("Iterations", std::min(iterations.load(), iterations_limit));
         opt_output->add("Runtime (s)", timer.count<std::chrono::milliseconds>() / 1000.0);
         opt_output->add("Start solution", std::get<double>(start));
         opt_output->add("Iteration of last improvement", iteration_last_improvement);
-    }
 
-    // Deallocate resources
-    for (auto ptr : neighborhoods) {
-        delete ptr;
+        // Performance counters of the local search (summed over the trajectories)
+        long vnd_calls = 0;
+        double vnd_time = 0.0;
+        for (int k = 0; k < trajectories; ++k) {
+            vnd_calls += trajectory[k].vnd_calls;
+            vnd_time += trajectory[k].vnd_timer.count<std::chrono::microseconds>() / 1000000.0;
+        }
+
+        opt_output->add("VND - calls", vnd_calls);
+        opt_output->add("VND - time (s)", vnd_time);
+
+        // Performance counters of the caches of visited solutions
+        if (visited_cache > 0) {
+            long hits = 0;
+            long misses = 0;
+            for (int k = 0; k < trajectories; ++k) {
+                hits += trajectory[k].visited->hits;
+                misses += trajectory[k].visited->misses;
+            }
+
+            opt_output->add("Visited cache - hits", hits);
+            opt_output->add("Visited cache - misses", misses);
+        }
+
+        // Number of solutions adopted from other trajectories
+        if (trajectories > 1 && migration_interval > 0) {
+            long migrations = 0;
+            for (int k = 0; k < trajectories; ++k) {
+                migrations += trajectory[k].migrations;
+            }
+
+            opt_output->add("Migrations", migrations);
+        }
+
+        for (auto& ptr : trajectory[0].neighborhoods) {
+            NeighborhoodStatistics statistics;
+            for (int k = 0; k < trajectories; ++k) {
+                for (auto& other : trajectory[k].neighborhoods) {
+                    if (other->name() == ptr->name()) {
+                        statistics.add(other->statistics);
+                    }
+                }
+            }
+
+            statistics.report("Neighborhood " + ptr->name(), opt_output);
+        }
     }
 
-    // Return the solution built
-    return incumbent;
+    // Return the best solution found
+    return best;
 }
 
-std::tuple<orcs::Schedule, double> orcs::ILS::perturb(const Problem& problem, const std::tuple<Schedule, double>& entry, std::mt19937& generator) {
+std::tuple<orcs::Schedule, double> orcs::ILS::perturb(const Problem& problem, const std::tuple<Schedule, double>& entry,
+        SearchContext& context, std::mt19937& generator) {
 
     // Create a copy of the original entry
     std::tuple<Schedule, double> perturbed = entry;
@@ -182,7 +402,7 @@ std::tuple<orcs::Schedule, double> orcs::ILS::perturb(const Problem& problem, co
                 schedule[l_target].insert(schedule[l_target].begin() + idx_target, operation);
 
                 // Check the feasibility of the movement
-                bool is_feasible = orcs::utils::evaluate(problem, perturbed);
+                bool is_feasible = orcs::utils::evaluate(problem, perturbed, context.evaluation);
 
                 if (is_feasible) {
                     success = true;
@@ -198,7 +418,7 @@ std::tuple<orcs::Schedule, double> orcs::ILS::perturb(const Problem& problem, co
             // Undo the movement, if not feasible
             if (!success) {
                 schedule[l_origin].insert(schedule[l_origin].begin() + idx_origin, operation);
-                orcs::utils::evaluate(problem, perturbed);
+                orcs::utils::evaluate(problem, perturbed, context.evaluation);
             }
 
         }
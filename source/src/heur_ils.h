@@ -1,10 +1,19 @@
 #ifndef MANEUVERS_SCHEDULING_ILS_H
 #define MANEUVERS_SCHEDULING_ILS_H
 
+#include <list>
+#include <memory>
 #include <random>
 
+#include <cxxtimer.hpp>
+
 #include "problem.h"
 #include "algorithm.h"
+#include "mailbox.h"
+#include "neighborhood.h"
+#include "search_context.h"
+#include "thread_pool.h"
+#include "visited_cache.h"
 
 
 namespace orcs {
@@ -13,6 +22,26 @@ namespace orcs {
      * This class implements an ILS-based heuristic for the maneuvers
      * scheduling problem in the restoration of electric power distribution
      * networks.
+     *
+     * Several independent trajectories of the ILS can be run in parallel (option
+     * "trajectories"), all of them from the same local optimum but with different
+     * random number generators. They share the best solution found and the
+     * stopping criteria (time and number of iterations, counted over all
+     * trajectories), and the threads (option "threads") are split among them.
+     *
+     * The trajectories may also cooperate as islands (option "migration-interval"):
+     * each one periodically publishes its incumbent solution, if it has changed, in
+     * its mailbox (see Mailbox), and when it stagnates (i.e., it reaches the highest
+     * perturbation strength) it adopts the best solution published by its
+     * neighbors, if better than its incumbent. In a ring topology, the neighbor of
+     * a trajectory is the previous one; in a complete topology, all other
+     * trajectories are its neighbors (option "migration-topology").
+     *
+     * Each trajectory may also keep a cache of the local optima found from its
+     * perturbed solutions (option "visited-cache", see VisitedCache), so the VND is
+     * not performed again from a perturbed solution already visited. Perturbed
+     * solutions seldom recur, so the cache only pays off in long runs on small
+     * instances.
      */
     class ILS : public Algorithm {
     public:
@@ -38,7 +67,24 @@ namespace orcs {
 
     private:
 
-        std::tuple<Schedule, double> perturb(const Problem& problem, const std::tuple<Schedule, double>& entry, std::mt19937& generator);
+        // Random number generator, search context (and the threads used to scan
+        // the neighborhoods), neighborhoods, VND counters, mailbox and number of
+        // solutions adopted from other trajectories and cache of visited solutions (if
+        // any) of a trajectory
+        struct Trajectory {
+            std::mt19937 generator;
+            std::unique_ptr<ThreadPool> pool;
+            std::unique_ptr<SearchContext> context;
+            std::list<std::unique_ptr<Neighborhood>> neighborhoods;
+            cxxtimer::Timer vnd_timer;
+            long vnd_calls = 0;
+            Mailbox mailbox;
+            long migrations = 0;
+            std::unique_ptr<VisitedCache> visited;
+        };
+
+        std::tuple<Schedule, double> perturb(const Problem& problem, const std::tuple<Schedule, double>& entry,
+                SearchContext& context, std::mt19937& generator);
 
         void log_header(bool verbose = true);
 
@@ -7,8 +7,25 @@
 #include "utils.h"
 
 
+/**
+ * Score of a neighborhood in the adaptive VND: upper confidence bound (UCB1) on the
+ * probability that a search finds an improving neighbor, divided by the mean time of
+ * a search. Neighborhoods never searched have the highest score.
+ */
+static double score(const orcs::NeighborhoodStatistics& statistics, long total_searches) {
+    if (statistics.searches == 0) {
+        return std::numeric_limits<double>::max();
+    }
+
+    double searches = statistics.searches;
+    double success = statistics.improving / searches + std::sqrt(2.0 * std::log(total_searches) / searches);
+    double time = std::max(statistics.time / searches, 1e-6);
+    return success / time;
+}
+
 std::tuple<orcs::Schedule, double> orcs::LocalSearch::best_improvement(const Problem& problem,
-        const std::tuple<Schedule, double>& entry, Neighborhood& neighborhood) {
+        const std::tuple<Schedule, double>& entry, Neighborhood& neighborhood,
+        SearchContext& context) {
 
     // Keep the best solution found
     std::tuple<Schedule, double> incumbent = entry;
@@ -18,23 +35,35 @@ std::tuple<orcs::Schedule, double> orcs::LocalSearch::best_improvement(const Pro
     while (!stop) {
 
         // Get a neighbor
-        std::tuple<Schedule, double> neighbor = neighborhood.best_improvement(problem, incumbent);
+        neighborhood.statistics.start_search();
+        std::tuple<Schedule, double> neighbor = neighborhood.best_improvement(problem, incumbent, context);
+        bool improving = utils::is_lower(std::get<double>(neighbor), std::get<double>(incumbent));
+        neighborhood.statistics.stop_search(improving);
 
         // Check for improvements
-        if (utils::is_lower(std::get<double>(neighbor), std::get<double>(incumbent))) {
+        if (improving) {
+            context.dont_look.activate_changes(std::get<Schedule>(incumbent), std::get<Schedule>(neighbor));
             incumbent = std::move(neighbor);
         } else {
             stop = true;
         }
+
+        // Stop if the deadline has expired
+        if (context.expired()) {
+            stop = true;
+        }
     }
 
+    // A local optimum has been reached, so no switch is active until it changes
+    context.dont_look.deactivate_all();
+
     // Return the best solution found
     return incumbent;
 }
 
 std::tuple<orcs::Schedule, double> orcs::LocalSearch::first_improvement(const Problem& problem,
         const std::tuple<Schedule, double>& entry, Neighborhood& neighborhood,
-        std::mt19937& generator) {
+        SearchContext& context, std::mt19937& generator) {
 
     // Keep the best solution found
     std::tuple<Schedule, double> incumbent = entry;
@@ -44,23 +73,36 @@ std::tuple<orcs::Schedule, double> orcs::LocalSearch::first_improvement(const Pr
     while (!stop) {
 
         // Get a neighbor
+        neighborhood.statistics.start_search();
         std::tuple<Schedule, double> neighbor = neighborhood.first_improvement(problem,
-                incumbent, generator);
+                incumbent, context, generator);
+        bool improving = utils::is_lower(std::get<double>(neighbor), std::get<double>(incumbent));
+        neighborhood.statistics.stop_search(improving);
 
         // Check for improvements
-        if (utils::is_lower(std::get<double>(neighbor), std::get<double>(incumbent))) {
+        if (improving) {
+            context.dont_look.activate_changes(std::get<Schedule>(incumbent), std::get<Schedule>(neighbor));
             incumbent = std::move(neighbor);
         } else {
             stop = true;
         }
+
+        // Stop if the deadline has expired
+        if (context.expired()) {
+            stop = true;
+        }
     }
 
+    // A local optimum has been reached, so no switch is active until it changes
+    context.dont_look.deactivate_all();
+
     // Return the best solution found
     return incumbent;
 }
 
 std::tuple<orcs::Schedule, double> orcs::LocalSearch::best_improvement_vnd(const Problem& problem,
-        const std::tuple<Schedule, double>& entry, std::list<Neighborhood*>& neighborhoods) {
+        const std::tuple<Schedule, double>& entry, std::list<std::unique_ptr<Neighborhood>>& neighborhoods,
+        SearchContext& context) {
 
     // Keep the best solution found
     std::tuple<Schedule, double> incumbent = entry;
@@ -70,15 +112,19 @@ std::tuple<orcs::Schedule, double> orcs::LocalSearch::best_improvement_vnd(const
     while (k != neighborhoods.end()) {
 
         // Get the neighborhood
-        Neighborhood* neighborhood = *k;
+        Neighborhood* neighborhood = k->get();
 
         // Get a neighbor
-        std::tuple<Schedule, double> neighbor = neighborhood->best_improvement(problem, incumbent);
+        neighborhood->statistics.start_search();
+        std::tuple<Schedule, double> neighbor = neighborhood->best_improvement(problem, incumbent, context);
+        bool improving = utils::is_lower(std::get<double>(neighbor), std::get<double>(incumbent));
+        neighborhood->statistics.stop_search(improving);
 
         // Check for improvements
-        if (utils::is_lower(std::get<double>(neighbor), std::get<double>(incumbent))) {
+        if (improving) {
 
-            // Update the incumbent solution
+            // Update the incumbent solution (the switches moved become active)
+            context.dont_look.activate_changes(std::get<Schedule>(incumbent), std::get<Schedule>(neighbor));
             incumbent = std::move(neighbor);
 
             // Go to the first neighborhood
@@ -89,16 +135,24 @@ std::tuple<orcs::Schedule, double> orcs::LocalSearch::best_improvement_vnd(const
             // Go to the next neighborhood
             ++k;
         }
+
+        // Stop if the deadline has expired
+        if (context.expired()) {
+            break;
+        }
     }
 
+    // A local optimum has been reached, so no switch is active until it changes
+    context.dont_look.deactivate_all();
+
     // Return the best solution found
     return incumbent;
 
 }
 
 std::tuple<orcs::Schedule, double> orcs::LocalSearch::first_improvement_vnd(const Problem& problem,
-        const std::tuple<Schedule, double>& entry, std::list<Neighborhood*>& neighborhoods,
-        std::mt19937& generator) {
+        const std::tuple<Schedule, double>& entry, std::list<std::unique_ptr<Neighborhood>>& neighborhoods,
+        SearchContext& context, std::mt19937& generator) {
 
     // Keep the best solution found
     std::tuple<Schedule, double> incumbent = entry;
@@ -108,16 +162,20 @@ std::tuple<orcs::Schedule, double> orcs::LocalSearch::first_improvement_vnd(cons
     while (k != neighborhoods.end()) {
 
         // Get the neighborhood
-        Neighborhood* neighborhood = *k;
+        Neighborhood* neighborhood = k->get();
 
         // Get a neighbor
+        neighborhood->statistics.start_search();
         std::tuple<Schedule, double> neighbor = neighborhood->first_improvement(problem,
-                incumbent, generator);
+                incumbent, context, generator);
+        bool improving = utils::is_lower(std::get<double>(neighbor), std::get<double>(incumbent));
+        neighborhood->statistics.stop_search(improving);
 
         // Check for improvements
-        if (utils::is_lower(std::get<double>(neighbor), std::get<double>(incumbent))) {
+        if (improving) {
 
-            // Update the incumbent solution
+            // Update the incumbent solution (the switches moved become active)
+            context.dont_look.activate_changes(std::get<Schedule>(incumbent), std::get<Schedule>(neighbor));
             incumbent = std::move(neighbor);
 
             // Go to the first neighborhood
@@ -128,9 +186,88 @@ std::tuple<orcs::Schedule, double> orcs::LocalSearch::first_improvement_vnd(cons
             // Go to the next neighborhood
             ++k;
         }
+
+        // Stop if the deadline has expired
+        if (context.expired()) {
+            break;
+        }
     }
 
+    // A local optimum has been reached, so no switch is active until it changes
+    context.dont_look.deactivate_all();
+
     // Return the best solution found
     return incumbent;
 
 }
+
+std::tuple<orcs::Schedule, double> orcs::LocalSearch::adaptive_vnd(const Problem& problem,
+        const std::tuple<Schedule, double>& entry, std::list<std::unique_ptr<Neighborhood>>& neighborhoods,
+        SearchContext& context) {
+
+    // Keep the best solution found
+    std::tuple<Schedule, double> incumbent = entry;
+
+    // Neighborhoods not searched yet from the incumbent solution
+    std::vector<Neighborhood*> all;
+    for (auto& neighborhood : neighborhoods) {
+        all.push_back(neighborhood.get());
+    }
+
+    std::vector<Neighborhood*> pending = all;
+
+    // Perform the local search
+    while (!pending.empty()) {
+
+        // Select the neighborhood with the highest score (the first one, among ties)
+        long total_searches = 0;
+        for (auto neighborhood : all) {
+            total_searches += neighborhood->statistics.searches;
+        }
+
+        auto selected = pending.begin();
+        double selected_score = score((*selected)->statistics, total_searches);
+        for (auto k = pending.begin() + 1; k != pending.end(); ++k) {
+            double k_score = score((*k)->statistics, total_searches);
+            if (k_score > selected_score) {
+                selected = k;
+                selected_score = k_score;
+            }
+        }
+
+        Neighborhood* neighborhood = *selected;
+
+        // Get a neighbor
+        neighborhood->statistics.start_search();
+        std::tuple<Schedule, double> neighbor = neighborhood->best_improvement(problem, incumbent, context);
+        bool improving = utils::is_lower(std::get<double>(neighbor), std::get<double>(incumbent));
+        neighborhood->statistics.stop_search(improving);
+
+        // Check for improvements
+        if (improving) {
+
+            // Update the incumbent solution (the switches moved become active)
+            context.dont_look.activate_changes(std::get<Schedule>(incumbent), std::get<Schedule>(neighbor));
+            incumbent = std::move(neighbor);
+
+            // All neighborhoods must be searched again
+            pending = all;
+
+        } else {
+
+            // The neighborhood is not searched again until an improvement
+            pending.erase(selected);
+        }
+
+        // Stop if the deadline has expired
+        if (context.expired()) {
+            break;
+        }
+    }
+
+    // A local optimum has been reached, so no switch is active until it changes
+    context.dont_look.deactivate_all();
+
+    // Return the best solution found
+    return incumbent;
+}
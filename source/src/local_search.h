@@ -2,17 +2,21 @@
 #define MANEUVERS_SCHEDULING_LOCAL_SEARCH_H
 
 #include <list>
+#include <memory>
 #include <random>
 
 #include "algorithm.h"
 #include "neighborhood.h"
 #include "problem.h"
+#include "search_context.h"
 
 
 namespace orcs {
 
     /**
-     * Class that implements a basic local search.
+     * Class that implements a basic local search. The searches stop early, returning
+     * the best solution found so far, if the deadline of the search context
+     * expires (see SearchContext::deadline).
      */
     class LocalSearch {
 
@@ -27,12 +31,15 @@ namespace orcs {
          *          The start solution to perform the local search.
          * @param   neighborhood
          *          The neighborhood used to perform the local search.
+         * @param   context
+         *          The search context (owned by the calling thread).
          *
          * @return  A tuple of two elements, in which the first is the
          *          schedule and the second is the makespan.
          */
         static std::tuple<orcs::Schedule, double> best_improvement(const Problem& problem,
-                const std::tuple<Schedule, double>& entry, Neighborhood& neighborhood);
+                const std::tuple<Schedule, double>& entry, Neighborhood& neighborhood,
+                SearchContext& context);
 
         /**
          * Perform the local search according to the first improvement rule.
@@ -43,6 +50,8 @@ namespace orcs {
          *          The start solution to perform the local search.
          * @param   neighborhood
          *          The neighborhood used to perform the local search.
+         * @param   context
+         *          The search context (owned by the calling thread).
          * @param   generator
          *          The random number generator.
          *
@@ -51,7 +60,7 @@ namespace orcs {
          */
         static std::tuple<orcs::Schedule, double> first_improvement(const Problem& problem,
                 const std::tuple<Schedule, double>& entry, Neighborhood& neighborhood,
-                std::mt19937& generator);
+                SearchContext& context, std::mt19937& generator);
 
         /**
          * Perform the local search according to variable neighborhood search (VND).
@@ -63,12 +72,15 @@ namespace orcs {
          *          The start solution to perform the local search.
          * @param   neighborhoods
          *          The list of neighborhood used to perform the VND.
+         * @param   context
+         *          The search context (owned by the calling thread).
          *
          * @return  A tuple of two elements, in which the first is the
          *          schedule and the second is the makespan.
          */
         static std::tuple<orcs::Schedule, double> best_improvement_vnd(const Problem& problem,
-                const std::tuple<Schedule, double>& entry, std::list<Neighborhood*>& neighborhoods);
+                const std::tuple<Schedule, double>& entry, std::list<std::unique_ptr<Neighborhood>>& neighborhoods,
+                SearchContext& context);
 
         /**
          * Perform the local search according to variable neighborhood search (VND).
@@ -80,6 +92,8 @@ namespace orcs {
          *          The start solution to perform the local search.
          * @param   neighborhood
          *          The list of neighborhood used to perform the VND.
+         * @param   context
+         *          The search context (owned by the calling thread).
          * @param   generator
          *          The random number generator.
          *
@@ -87,8 +101,36 @@ namespace orcs {
          *          schedule and the second is the makespan.
          */
         static std::tuple<orcs::Schedule, double> first_improvement_vnd(const Problem& problem,
-                const std::tuple<Schedule, double>& entry, std::list<Neighborhood*>& neighborhoods,
-                std::mt19937& generator);
+                const std::tuple<Schedule, double>& entry, std::list<std::unique_ptr<Neighborhood>>& neighborhoods,
+                SearchContext& context, std::mt19937& generator);
+
+        /**
+         * Perform the local search according to an adaptive variable neighborhood
+         * descent. Instead of a fixed order, the next neighborhood is the one (among
+         * the ones not searched yet from the incumbent solution) with the highest
+         * upper confidence bound (UCB1) on its rate of improving searches per second
+         * of search, computed from the statistics of the neighborhoods (see
+         * NeighborhoodStatistics), so it adapts over successive calls. As in the VND,
+         * all neighborhoods are searched again after an improvement, and the search
+         * stops at a local optimum with respect to all of them. This method uses the
+         * best improvement rule. Since the order depends on the time measured, the
+         * result is not reproducible.
+         *
+         * @param   problem
+         *          Instance of the problem being optimized.
+         * @param   entry
+         *          The start solution to perform the local search.
+         * @param   neighborhoods
+         *          The list of neighborhood used to perform the VND.
+         * @param   context
+         *          The search context (owned by the calling thread).
+         *
+         * @return  A tuple of two elements, in which the first is the
+         *          schedule and the second is the makespan.
+         */
+        static std::tuple<orcs::Schedule, double> adaptive_vnd(const Problem& problem,
+                const std::tuple<Schedule, double>& entry, std::list<std::unique_ptr<Neighborhood>>& neighborhoods,
+                SearchContext& context);
     };
 
 }
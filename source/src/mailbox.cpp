@@ -0,0 +1,18 @@
+#include "mailbox.h"
+
+
+orcs::Mailbox::Mailbox() :
+        latest(nullptr) {
+
+}
+
+void orcs::Mailbox::publish(const std::tuple<Schedule, double>& entry) {
+
+    // The copy is complete before it becomes visible to the readers
+    published.emplace_back(new std::tuple<Schedule, double>(entry));
+    latest.store(published.back().get(), std::memory_order_release);
+}
+
+const std::tuple<orcs::Schedule, double>* orcs::Mailbox::read() const {
+    return latest.load(std::memory_order_acquire);
+}
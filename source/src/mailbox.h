@@ -0,0 +1,58 @@
+#ifndef MANEUVERS_SCHEDULING_MAILBOX_H
+#define MANEUVERS_SCHEDULING_MAILBOX_H
+
+#include <atomic>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "problem.h"
+
+
+namespace orcs {
+
+    /**
+     * Mailbox in which a thread publishes solutions to be read by other threads
+     * (e.g., the elite solution of an island of the ILS). Publishing and reading do
+     * not lock: a published solution is never changed and it is only released when
+     * the mailbox is destroyed, so a reader can keep using it after a newer one is
+     * published. Only one thread may publish in a mailbox, and it should publish
+     * few solutions (e.g., only when they improve), since all of them are kept.
+     */
+    class Mailbox {
+
+    public:
+
+        /**
+         * Constructor. Creates an empty mailbox.
+         */
+        Mailbox();
+
+        Mailbox(const Mailbox&) = delete;
+        Mailbox& operator=(const Mailbox&) = delete;
+
+        /**
+         * Publish a solution (a copy of it is stored).
+         *
+         * @param   entry
+         *          The solution, as a tuple of the schedule and the makespan.
+         */
+        void publish(const std::tuple<Schedule, double>& entry);
+
+        /**
+         * Return the solution published last, which remains valid while the mailbox
+         * exists, or nullptr if no solution has been published.
+         */
+        const std::tuple<Schedule, double>* read() const;
+
+    private:
+
+        std::atomic<const std::tuple<Schedule, double>*> latest;
+        std::vector< std::unique_ptr< std::tuple<Schedule, double> > > published;
+
+    };
+
+}
+
+
+#endif
@@ -66,6 +66,12 @@ int main(int argc, char** argv) {
             throw std::string("Invalid algorithm.");
         }
 
+        // Abort, if the migration topology of the ILS is invalid
+        std::set<std::string> opt_topologies = {"ring", "complete"};
+        if (opt_topologies.count(options["migration-topology"].as<std::string>()) < 1) {
+            throw std::string("Invalid migration topology.");
+        }
+
         // Load the problem
         orcs::Problem problem(options["file"].as<std::string>());
 
@@ -85,6 +91,17 @@ int main(int argc, char** argv) {
         } else if (options["algorithm"].as<std::string>() == "ils") {
             algorithm = new orcs::ILS();
             opt_input.add("perturbation-passes-limit", options["perturbation-passes-limit"].as<long>());
+            opt_input.add("trajectories", options["trajectories"].as<int>());
+            opt_input.add("migration-interval", options["migration-interval"].as<long>());
+            opt_input.add("migration-topology", options["migration-topology"].as<std::string>());
+            opt_input.add("dont-look-bits", options["dont-look-bits"].as<bool>());
+            opt_input.add("granularity", options["granularity"].as<int>());
+            opt_input.add("or-opt", options["or-opt"].as<bool>());
+            opt_input.add("tail-exchange", options["tail-exchange"].as<bool>());
+            opt_input.add("pair-swap", options["pair-swap"].as<bool>());
+            opt_input.add("critical-path", options["critical-path"].as<bool>());
+            opt_input.add("adaptive-vnd", options["adaptive-vnd"].as<bool>());
+            opt_input.add("visited-cache", options["visited-cache"].as<long>());
 
         } else if (options["algorithm"].as<std::string>() == "mip-precedence") {
             algorithm = new orcs::MIPPrecedence();
@@ -259,7 +276,8 @@ cxxopts::Options init_parser(int argc, char** argv) {
                      "objective function, followed by the value of the objective function, the "
                      "runtime in seconds, the number of iterations - or MIP nodes explored for MIP "
                      "formulations -, the value of the linear relaxation, and the MIP optimality "
-                     "gap; (3) show a more detailed report about the optimization process. The "
+                     "gap; (3) show a more detailed report about the optimization process (for the ILS, it "
+                     "includes the performance counters of the VND and of each neighborhood). The "
                      "possible status are ERROR, UNKNOWN, SUBOPTIMAL, OPTIMAL, INFEASIBLE, "
                      "UNBOUNDED, INF_OR_UNBD. All values are separated by a single blank space. If "
                      "some information is not available, a question mark is printed in its place).",
@@ -301,11 +319,79 @@ cxxopts::Options init_parser(int argc, char** argv) {
              "VALUE");
 
     options.add_options("ILS")
+            ("trajectories",
+             "Number of independent trajectories of the ILS run in parallel (with different seeds), "
+                     "which share the best solution found, the time limit and the iterations limit. "
+                     "The threads are split among them.",
+             cxxopts::value<int>()
+                     ->default_value("1"),
+             "VALUE")
+            ("migration-interval",
+             "If greater than 0 (zero), the trajectories cooperate as islands: every VALUE "
+                     "iterations, each trajectory publishes its incumbent solution (if it has "
+                     "changed), and a trajectory that reaches the highest perturbation strength "
+                     "adopts the best solution published by its neighbors, if better.",
+             cxxopts::value<long>()
+                     ->default_value("0"),
+             "VALUE")
+            ("migration-topology",
+             "Neighbors of the trajectories for migration. Valid values are: ring (the neighbor of "
+                     "a trajectory is the previous one) and complete (all other trajectories).",
+             cxxopts::value<std::string>()
+                     ->default_value("ring"),
+             "VALUE")
             ("perturbation-passes-limit",
              "The highest value of perturbation strength. If no improvement is found after a "
                      "perturbation with this strength, the ILS stops.",
              cxxopts::value<long>()
                     ->default_value("5"),
+             "VALUE")
+            ("dont-look-bits",
+             "If set, the VND performed after a perturbation only examines moves of switches whose "
+                     "neighbors in the sequence of their team have changed (by the perturbation or by "
+                     "improving moves).",
+             cxxopts::value<bool>(),
+             "")
+            ("granularity",
+             "Number of candidates (nearest switches) of each switch in the granular reassignment "
+                     "and swap neighborhoods, which only insert a switch next to its candidates. If set "
+                     "to 0 (zero), all moves are considered.",
+             cxxopts::value<int>()
+                     ->default_value("0"),
+             "VALUE")
+            ("or-opt",
+             "If set, the VND also moves segments of 2 to 3 consecutive switches within and across "
+                     "teams (after the other neighborhoods).",
+             cxxopts::value<bool>(),
+             "")
+            ("tail-exchange",
+             "If set, the VND also exchanges the tails of the sequences of two teams (after the "
+                     "other neighborhoods).",
+             cxxopts::value<bool>(),
+             "")
+            ("pair-swap",
+             "If set, the VND also exchanges pairs of switches of different teams in place (each "
+                     "one takes the position of the other one), before the swap neighborhood.",
+             cxxopts::value<bool>(),
+             "")
+            ("critical-path",
+             "If set, the shift, reassignment and swap neighborhoods only examine moves of switches "
+                     "in the critical path of the current solution (the chain of maneuvers that "
+                     "determines its makespan).",
+             cxxopts::value<bool>(),
+             "")
+            ("adaptive-vnd",
+             "If set, the VND selects the next neighborhood by its rate of improvements per second "
+                     "of search so far, instead of the fixed order (results are not reproducible, "
+                     "since they depend on the time measured).",
+             cxxopts::value<bool>(),
+             "")
+            ("visited-cache",
+             "Number of perturbed solutions (and local optima) whose local optimum is cached by each "
+                     "trajectory of the ILS, so the VND is not performed again from them (the least "
+                     "recently used ones are replaced). If set to 0 (zero), no solution is cached.",
+             cxxopts::value<long>()
+                     ->default_value("0"),
              "VALUE");
 
     options.add_options("MIP formulations")
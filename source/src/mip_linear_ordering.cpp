@@ -26,11 +26,11 @@ std::tuple<orcs::Schedule, double> orcs::MIPLinearOrdering::solve(const Problem&
     auto n = problem.n;
     auto m = problem.m;
     auto s = problem.s;
-    const auto& c = problem.c;
+    auto c = [&problem](int i, int j, int l) { return problem.c(i, j, l); };
     const auto& p = problem.p;
     const auto& technology = problem.technology;
     const auto& action = problem.action;
-    const auto& predecessors = problem.predecessors;
+    const auto& predecessors = problem.predecessors_csr;
 
     // Compute the big-M value
     double M = 0.0;
@@ -40,7 +40,7 @@ std::tuple<orcs::Schedule, double> orcs::MIPLinearOrdering::solve(const Problem&
             for (int i = 0; i <= n; ++i) {
                 if (i != j && technology[i] != Technology::REMOTE) {
                     for (int l = 1; l <= m; ++l) {
-                        max_c = std::max(max_c, c[i][j][l]);
+                        max_c = std::max(max_c, c(i, j, l));
                     }
                 }
             }
@@ -218,7 +218,7 @@ std::tuple<orcs::Schedule, double> orcs::MIPLinearOrdering::solve(const Problem&
             if (technology[i] != Technology::REMOTE) {
                 GRBLinExpr expr = 0;
                 for (int l = 1; l <= m; ++l) {
-                    expr += c[0][i][l] * y[i][l];
+                    expr += c(0, i, l) * y[i][l];
                 }
                 model.addConstr(t[i] >= t[0] + p[0] + expr);
             }
@@ -231,7 +231,7 @@ std::tuple<orcs::Schedule, double> orcs::MIPLinearOrdering::solve(const Problem&
                     if (j != i && technology[j] != Technology::REMOTE) {
                         GRBLinExpr expr = 0;
                         for (int l = 1; l <= m; ++l) {
-                            expr += c[i][j][l] * y[j][l];
+                            expr += c(i, j, l) * y[j][l];
                         }
                         model.addConstr(t[j] >= t[i] + p[i] + expr - M * (1 - z[i][j]));
                     }
@@ -26,20 +26,18 @@ std::tuple<orcs::Schedule, double> orcs::MIPPrecedence::solve(const Problem& pro
     auto n = problem.n;
     auto m = problem.m;
     auto s = problem.s;
-    auto c = problem.c;
     auto p = problem.p;
     auto technology = problem.technology;
     auto action = problem.action;
-    const auto& predecessors = problem.predecessors;
+    const auto& predecessors = problem.predecessors_csr;
 
     // Add info about the dummy node (n+1)
     action.push_back(Action::UNKNOWN);
     technology.push_back(Technology::UNKNOWN);
     p.push_back(0);
-    c.push_back(std::vector< std::vector<double> >(n + 2, std::vector<double>(m + 1, 0)));
-    for (int i = 0; i <= n; ++i) {
-        c[i].push_back(std::vector<double>(m + 1, 0));
-    }
+    auto c = [&problem, n](int i, int j, int l) {
+        return (i <= n && j <= n ? problem.c(i, j, l) : 0.0);
+    };
 
     // Compute the big-M value
     double M = 0.0;
@@ -49,7 +47,7 @@ std::tuple<orcs::Schedule, double> orcs::MIPPrecedence::solve(const Problem& pro
             for (int i = 0; i <= n; ++i) {
                 if (i != j && technology[i] != Technology::REMOTE) {
                     for (int l = 1; l <= m; ++l) {
-                        max_c = std::max(max_c, c[i][j][l]);
+                        max_c = std::max(max_c, c(i, j, l));
                     }
                 }
             }
@@ -227,7 +225,7 @@ std::tuple<orcs::Schedule, double> orcs::MIPPrecedence::solve(const Problem& pro
                 for (int j = 1; j <= n + 1; ++j) {
                     if (j != i && technology[j] != Technology::REMOTE) {
                         for (int l = 1; l <= m; ++l) {
-                            model.addConstr(t[j] >= t[i] + p[i] + c[i][j][l] - M * (1 - x[i][j][l]));
+                            model.addConstr(t[j] >= t[i] + p[i] + c(i, j, l) - M * (1 - x[i][j][l]));
                         }
                     }
                 }
@@ -0,0 +1,585 @@
+#include "move.h"
+
+#include <algorithm>
+
+
+orcs::Move orcs::Move::shift(int l, int idx_origin, int idx_target) {
+    Move move;
+    move.type = MoveType::SHIFT;
+    move.l1 = l;
+    move.idx1 = idx_origin;
+    move.target1 = idx_target;
+    return move;
+}
+
+orcs::Move orcs::Move::reassign(int l_origin, int idx_origin, int l_target, int idx_target) {
+    Move move;
+    move.type = MoveType::REASSIGN;
+    move.l1 = l_origin;
+    move.idx1 = idx_origin;
+    move.target1 = idx_target;
+    move.l2 = l_target;
+    return move;
+}
+
+orcs::Move orcs::Move::swap(int l1, int idx1, int target1, int l2, int idx2, int target2) {
+    Move move;
+    move.type = MoveType::SWAP;
+    move.l1 = l1;
+    move.idx1 = idx1;
+    move.target1 = target1;
+    move.l2 = l2;
+    move.idx2 = idx2;
+    move.target2 = target2;
+    return move;
+}
+
+orcs::Move orcs::Move::pair_swap(int l1, int idx1, int l2, int idx2) {
+    Move move = swap(l1, idx1, idx2, l2, idx2, idx1);
+    move.type = MoveType::PAIR_SWAP;
+    return move;
+}
+
+orcs::Move orcs::Move::or_opt(int l_origin, int idx_origin, int length, int l_target, int idx_target) {
+    Move move;
+    move.type = MoveType::OR_OPT;
+    move.l1 = l_origin;
+    move.idx1 = idx_origin;
+    move.length = length;
+    move.target1 = idx_target;
+    move.l2 = l_target;
+    return move;
+}
+
+orcs::Move orcs::Move::tail_exchange(int l1, int idx1, int l2, int idx2) {
+    Move move;
+    move.type = MoveType::TAIL_EXCHANGE;
+    move.l1 = l1;
+    move.idx1 = idx1;
+    move.l2 = l2;
+    move.idx2 = idx2;
+    return move;
+}
+
+bool orcs::Move::accept(const MoveFilter& filter, const FlatSchedule& base) const {
+    switch (type) {
+        case MoveType::SHIFT:
+            return filter.accept_insertion(base.switch_at(l1, idx1), l1, target1, idx1);
+
+        case MoveType::REASSIGN:
+            return filter.accept_insertion(base.switch_at(l1, idx1), l2, target1);
+
+        case MoveType::SWAP:
+        case MoveType::PAIR_SWAP:
+            return filter.accept_exchange(base.switch_at(l1, idx1), l1, idx1, target1,
+                    base.switch_at(l2, idx2), l2, idx2, target2);
+
+        case MoveType::OR_OPT:
+            return filter.accept_segment(&base.switches[base.offset[l1] + idx1], length, l1, idx1, l2, target1);
+
+        case MoveType::TAIL_EXCHANGE:
+            return filter.accept_append(&base.switches[base.offset[l1] + idx1], base.size(l1) - idx1, l2, idx2) &&
+                   filter.accept_append(&base.switches[base.offset[l2] + idx2], base.size(l2) - idx2, l1, idx1);
+    }
+
+    return true;
+}
+
+template <class Predicate>
+bool orcs::Move::any_switch(const FlatSchedule& base, Predicate predicate) const {
+
+    // The switches around the cut points of a tail exchange get new neighbors
+    if (type == MoveType::TAIL_EXCHANGE) {
+        for (int idx = idx1 - 1; idx <= idx1; ++idx) {
+            if (idx >= 0 && idx < base.size(l1) && predicate(base.switch_at(l1, idx))) {
+                return true;
+            }
+        }
+
+        for (int idx = idx2 - 1; idx <= idx2; ++idx) {
+            if (idx >= 0 && idx < base.size(l2) && predicate(base.switch_at(l2, idx))) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    for (int k = 0; k < length; ++k) {
+        if (predicate(base.switch_at(l1, idx1 + k))) {
+            return true;
+        }
+    }
+
+    return (type == MoveType::SWAP || type == MoveType::PAIR_SWAP) && predicate(base.switch_at(l2, idx2));
+}
+
+template <class Predicate>
+bool orcs::Move::any_neighbor(const FlatSchedule& base, Predicate predicate) const {
+
+    // Switch at position idx of team l of the base schedule (if any)
+    auto at = [&base, &predicate](int l, int idx) {
+        return idx >= 0 && idx < base.size(l) && predicate(base.switch_at(l, idx));
+    };
+
+    // Switches around position idx of team l once the switches from position first to
+    // position last - 1 are removed (the positions of insertions refer to such sequences)
+    auto around = [&at](int l, int idx, int first, int last) {
+        return at(l, (idx - 1 < first ? idx - 1 : idx - 1 + last - first)) ||
+               at(l, (idx < first ? idx : idx + last - first));
+    };
+
+    switch (type) {
+        case MoveType::SHIFT:
+            return at(l1, idx1 - 1) || at(l1, idx1 + 1) || around(l1, target1, idx1, idx1 + 1);
+
+        case MoveType::REASSIGN:
+            return at(l1, idx1 - 1) || at(l1, idx1 + 1) || around(l2, target1, 0, 0);
+
+        case MoveType::SWAP:
+        case MoveType::PAIR_SWAP:
+            return at(l1, idx1 - 1) || at(l1, idx1 + 1) || at(l2, idx2 - 1) || at(l2, idx2 + 1) ||
+                   around(l2, target1, idx2, idx2 + 1) || around(l1, target2, idx1, idx1 + 1);
+
+        case MoveType::OR_OPT:
+            return at(l1, idx1 - 1) || at(l1, idx1 + length) ||
+                   (l1 == l2 ? around(l2, target1, idx1, idx1 + length) : around(l2, target1, 0, 0));
+
+        case MoveType::TAIL_EXCHANGE:
+            // The switches around the cut points are the ones tested by any_switch
+            return false;
+    }
+
+    return false;
+}
+
+bool orcs::Move::involves(const DontLookBits& dont_look, const FlatSchedule& base) const {
+    int layer = static_cast<int>(type);
+    auto active = [&dont_look, layer](int j) { return dont_look.is_active(layer, j); };
+    return any_switch(base, active) || (dont_look.enabled() && any_neighbor(base, active));
+}
+
+bool orcs::Move::touches(const DeltaEvaluator& evaluator, const FlatSchedule& base) const {
+    return any_switch(base, [&evaluator](int j) { return evaluator.is_critical(j); });
+}
+
+bool orcs::Move::price(const SegmentData& segments, double& makespan) const {
+    if (type == MoveType::SWAP || type == MoveType::PAIR_SWAP) {
+        return segments.price_exchange(l1, idx1, target1, l2, idx2, target2, makespan);
+    } else if (type == MoveType::OR_OPT) {
+        return segments.price_segment(l1, idx1, length, l2, target1, makespan);
+    } else if (type == MoveType::TAIL_EXCHANGE) {
+        return segments.price_tails(l1, idx1, l2, idx2, makespan);
+    }
+
+    makespan = 0.0;
+    return false;
+}
+
+void orcs::Move::apply(FlatSchedule& schedule) const {
+    switch (type) {
+        case MoveType::SHIFT:
+            schedule.move(l1, idx1, 1, l1, target1);
+            break;
+
+        case MoveType::REASSIGN:
+            schedule.move(l1, idx1, 1, l2, target1);
+            break;
+
+        case MoveType::SWAP:
+        case MoveType::PAIR_SWAP:
+            schedule.exchange(l1, idx1, target1, l2, idx2, target2);
+            break;
+
+        case MoveType::OR_OPT:
+            schedule.move(l1, idx1, length, l2, target1);
+            break;
+
+        case MoveType::TAIL_EXCHANGE:
+            schedule.exchange_tails(l1, idx1, l2, idx2);
+            break;
+    }
+}
+
+void orcs::Move::undo(FlatSchedule& schedule) const {
+    switch (type) {
+        case MoveType::SHIFT:
+            schedule.move(l1, target1, 1, l1, idx1);
+            break;
+
+        case MoveType::REASSIGN:
+            schedule.move(l2, target1, 1, l1, idx1);
+            break;
+
+        case MoveType::SWAP:
+        case MoveType::PAIR_SWAP:
+            // The second switch is at position target2 of team l1 and the first one at
+            // position target1 of team l2
+            schedule.exchange(l1, target2, idx2, l2, target1, idx1);
+            break;
+
+        case MoveType::OR_OPT:
+            schedule.move(l2, target1, length, l1, idx1);
+            break;
+
+        case MoveType::TAIL_EXCHANGE:
+            schedule.exchange_tails(l1, idx1, l2, idx2);
+            break;
+    }
+}
+
+orcs::EvaluationStatus orcs::Move::evaluate(DeltaEvaluator& evaluator, const FlatSchedule& schedule,
+        double& makespan, double bound) const {
+
+    // Only the suffixes of the sequences from the first changed position are evaluated
+    switch (type) {
+        case MoveType::SHIFT:
+            return evaluator.evaluate(schedule, makespan, l1, std::min(idx1, target1), -1, -1, bound);
+
+        case MoveType::REASSIGN:
+            return evaluator.evaluate(schedule, makespan, l1, idx1, l2, target1, bound);
+
+        case MoveType::SWAP:
+        case MoveType::PAIR_SWAP:
+            return evaluator.evaluate(schedule, makespan, l1, std::min(idx1, target2),
+                    l2, std::min(idx2, target1), bound);
+
+        case MoveType::OR_OPT:
+            if (l1 == l2) {
+                return evaluator.evaluate(schedule, makespan, l1, std::min(idx1, target1), -1, -1, bound);
+            }
+
+            return evaluator.evaluate(schedule, makespan, l1, idx1, l2, target1, bound);
+
+        case MoveType::TAIL_EXCHANGE:
+            return evaluator.evaluate(schedule, makespan, l1, idx1, l2, idx2, bound);
+    }
+
+    return EvaluationStatus::INFEASIBLE;
+}
+
+std::tuple<orcs::Schedule, double> orcs::Move::materialize(DeltaEvaluator& evaluator, FlatSchedule& schedule) const {
+
+    // Apply the move and compute the moments of the neighbor
+    double makespan;
+    apply(schedule);
+    if (evaluate(evaluator, schedule, makespan) == EvaluationStatus::FEASIBLE) {
+        evaluator.store(schedule);
+    }
+
+    return std::make_tuple(schedule.to_schedule(), makespan);
+}
+
+orcs::MoveSpace::MoveSpace(MoveType type, const FlatSchedule& base, const CandidateLists* candidates) :
+        type(type),
+        base(&base),
+        n_teams(static_cast<int>(base.offset.size()) - 2),
+        n_slots(0),
+        offset(1, 0) {
+
+    // Number of positions in which a switch can be inserted in the sequences of teams
+    // 1 to m (i.e., the targets of a reassignment)
+    for (int l = 1; l <= n_teams; ++l) {
+        n_slots += base.size(l) + 1;
+    }
+
+    // Define the groups of moves and their sizes
+    auto add = [this](int first, int second, std::uint64_t count) {
+        if (count > 0) {
+            group_first.push_back(first);
+            group_second.push_back(second);
+            offset.push_back(offset.back() + count);
+        }
+    };
+
+    // Granular reassignments and swaps
+    if (candidates != nullptr && (type == MoveType::REASSIGN || type == MoveType::SWAP)) {
+        load_candidates(*candidates);
+
+        std::size_t stride = prefix_reassign.size();
+        for (int l1 = 1; l1 <= n_teams; ++l1) {
+            std::size_t begin1 = base.offset[l1] - first_switch;
+            std::size_t end1 = base.offset[l1 + 1] - first_switch;
+
+            if (type == MoveType::REASSIGN) {
+                add(l1, l1, prefix_reassign[end1] - prefix_reassign[begin1]);
+                continue;
+            }
+
+            for (int l2 = l1 + 1; l2 <= n_teams; ++l2) {
+                std::size_t begin2 = base.offset[l2] - first_switch;
+                std::size_t end2 = base.offset[l2 + 1] - first_switch;
+                const std::uint64_t* prefix1 = prefix.data() + (l2 - 1) * stride;
+                const std::uint64_t* prefix2 = prefix.data() + (l1 - 1) * stride;
+                add(l1, l2, (prefix1[end1] - prefix1[begin1]) * (prefix2[end2] - prefix2[begin2]));
+            }
+        }
+
+        return;
+    }
+
+    switch (type) {
+        case MoveType::SHIFT:
+            for (int l = 0; l <= n_teams; ++l) {
+                std::uint64_t s = base.size(l);
+                add(l, l, s * (s > 0 ? s - 1 : 0));
+            }
+            break;
+
+        case MoveType::REASSIGN:
+            for (int l = 1; l <= n_teams; ++l) {
+                std::uint64_t s = base.size(l);
+                add(l, l, s * (n_slots - (s + 1)));
+            }
+            break;
+
+        case MoveType::SWAP:
+            for (int l1 = 1; l1 <= n_teams; ++l1) {
+                for (int l2 = l1 + 1; l2 <= n_teams; ++l2) {
+                    std::uint64_t s1 = base.size(l1);
+                    std::uint64_t s2 = base.size(l2);
+                    add(l1, l2, s1 * s2 * s2 * s1);
+                }
+            }
+            break;
+
+        case MoveType::PAIR_SWAP:
+            for (int l1 = 1; l1 <= n_teams; ++l1) {
+                for (int l2 = l1 + 1; l2 <= n_teams; ++l2) {
+                    std::uint64_t s1 = base.size(l1);
+                    std::uint64_t s2 = base.size(l2);
+                    add(l1, l2, s1 * s2);
+                }
+            }
+            break;
+
+        case MoveType::OR_OPT:
+            for (int l = 1; l <= n_teams; ++l) {
+                for (int length = min_segment; length <= max_segment; ++length) {
+                    std::uint64_t s = base.size(l);
+                    if (s >= static_cast<std::uint64_t>(length)) {
+                        add(l, length, (s - length + 1) * (s - length + n_slots - (s + 1)));
+                    }
+                }
+            }
+            break;
+
+        case MoveType::TAIL_EXCHANGE:
+            // All pairs of cut points but the one that exchanges two empty tails
+            for (int l1 = 1; l1 <= n_teams; ++l1) {
+                for (int l2 = l1 + 1; l2 <= n_teams; ++l2) {
+                    std::uint64_t s1 = base.size(l1);
+                    std::uint64_t s2 = base.size(l2);
+                    add(l1, l2, (s1 + 1) * (s2 + 1) - 1);
+                }
+            }
+            break;
+    }
+}
+
+orcs::Move orcs::MoveSpace::operator[](std::uint64_t k) const {
+
+    // Find the group of the move and its index inside the group
+    std::size_t g = std::upper_bound(offset.begin(), offset.end(), k) - offset.begin() - 1;
+    k -= offset[g];
+
+    int l1 = group_first[g];
+    int l2 = group_second[g];
+
+    if (granular) {
+        return granular_move(l1, l2, k);
+    }
+
+    switch (type) {
+        case MoveType::SHIFT: {
+            int s = base->size(l1);
+            int idx_origin = static_cast<int>(k / (s - 1));
+            int idx_target = static_cast<int>(k % (s - 1));
+            return Move::shift(l1, idx_origin, (idx_target < idx_origin ? idx_target : idx_target + 1));
+        }
+
+        case MoveType::REASSIGN: {
+            std::uint64_t targets = n_slots - (base->size(l1) + 1);
+            int idx_origin = static_cast<int>(k / targets);
+            std::uint64_t r = k % targets;
+
+            // Find the target team (teams other than the origin one, in increasing order)
+            int l_target = 1;
+            while (l_target == l1 || r >= static_cast<std::uint64_t>(base->size(l_target) + 1)) {
+                if (l_target != l1) {
+                    r -= base->size(l_target) + 1;
+                }
+                ++l_target;
+            }
+
+            return Move::reassign(l1, idx_origin, l_target, static_cast<int>(r));
+        }
+
+        case MoveType::SWAP: {
+            std::uint64_t s1 = base->size(l1);
+            std::uint64_t s2 = base->size(l2);
+            int target2 = static_cast<int>(k % s1);
+            k /= s1;
+            int target1 = static_cast<int>(k % s2);
+            k /= s2;
+            int idx2 = static_cast<int>(k % s2);
+            int idx1 = static_cast<int>(k / s2);
+            return Move::swap(l1, idx1, target1, l2, idx2, target2);
+        }
+
+        case MoveType::PAIR_SWAP: {
+            std::uint64_t s2 = base->size(l2);
+            return Move::pair_swap(l1, static_cast<int>(k / s2), l2, static_cast<int>(k % s2));
+        }
+
+        case MoveType::OR_OPT: {
+            int length = l2;
+            std::uint64_t s = base->size(l1);
+            std::uint64_t targets = s - length + n_slots - (s + 1);
+            int idx_origin = static_cast<int>(k / targets);
+            std::uint64_t r = k % targets;
+
+            // Positions of the origin team (but the current one) come first
+            if (r < s - length) {
+                int idx_target = static_cast<int>(r);
+                return Move::or_opt(l1, idx_origin, length, l1, (idx_target < idx_origin ? idx_target : idx_target + 1));
+            }
+
+            // Find the target team (teams other than the origin one, in increasing order)
+            r -= s - length;
+            int l_target = 1;
+            while (l_target == l1 || r >= static_cast<std::uint64_t>(base->size(l_target) + 1)) {
+                if (l_target != l1) {
+                    r -= base->size(l_target) + 1;
+                }
+                ++l_target;
+            }
+
+            return Move::or_opt(l1, idx_origin, length, l_target, static_cast<int>(r));
+        }
+
+        case MoveType::TAIL_EXCHANGE: {
+            std::uint64_t s2 = base->size(l2);
+            return Move::tail_exchange(l1, static_cast<int>(k / (s2 + 1)), l2, static_cast<int>(k % (s2 + 1)));
+        }
+    }
+
+    return Move();
+}
+
+void orcs::MoveSpace::load_candidates(const CandidateLists& candidates) {
+
+    const FlatSchedule& base = *this->base;
+    granular = true;
+    first_switch = base.offset[1];
+
+    // Team and position of each switch
+    int n_switches = static_cast<int>(base.switches.size());
+    std::vector<int> team(n_switches + 1, 0);
+    std::vector<int> position(n_switches + 1, 0);
+    for (int l = 0; l <= n_teams; ++l) {
+        for (int idx = 0; idx < base.size(l); ++idx) {
+            team[base.switch_at(l, idx)] = l;
+            position[base.switch_at(l, idx)] = idx;
+        }
+    }
+
+    // Positions next to the candidates of each switch, in each team other than its
+    // own one (a position idx means inserting the switch before the switch at
+    // position idx of the base schedule)
+    int n_granular = base.offset[n_teams + 1] - first_switch;
+    slot_offset.assign(1, 0);
+    for (int r = 0; r < n_granular; ++r) {
+        int j = base.switches[first_switch + r];
+        for (int l = 1; l <= n_teams; ++l) {
+            std::size_t first = slots.size();
+            if (l != team[j]) {
+                const int* nearest = candidates.nearest(j, l);
+                for (int c = 0; c < candidates.size(); ++c) {
+                    int i = nearest[c];
+                    if (i == 0) {
+                        slots.push_back(0);
+                    } else if (team[i] == l) {
+                        slots.push_back(position[i]);
+                        slots.push_back(position[i] + 1);
+                    }
+                }
+
+                std::sort(slots.begin() + first, slots.end());
+                slots.erase(std::unique(slots.begin() + first, slots.end()), slots.end());
+            }
+
+            slot_offset.push_back(static_cast<int>(slots.size()));
+        }
+    }
+
+    // Number of positions of the switches before each one
+    std::size_t stride = n_granular + 1;
+    prefix.assign(n_teams * stride, 0);
+    prefix_reassign.assign(stride, 0);
+    for (int r = 0; r < n_granular; ++r) {
+        prefix_reassign[r + 1] = prefix_reassign[r];
+        for (int l = 1; l <= n_teams; ++l) {
+            std::uint64_t count = slot_offset[r * n_teams + l] - slot_offset[r * n_teams + l - 1];
+            prefix[(l - 1) * stride + r + 1] = prefix[(l - 1) * stride + r] + count;
+            prefix_reassign[r + 1] += count;
+        }
+    }
+}
+
+orcs::Move orcs::MoveSpace::granular_move(int l1, int l2, std::uint64_t k) const {
+
+    // Find the switch (among the ones of team l) whose positions include the k-th
+    // position counted from the first switch of team l, and that position
+    std::size_t stride = prefix_reassign.size();
+    auto locate = [this](const std::uint64_t* counts, int l, std::uint64_t k, int& r) {
+        std::size_t begin = base->offset[l] - first_switch;
+        std::size_t end = base->offset[l + 1] - first_switch;
+        k += counts[begin];
+        r = static_cast<int>(std::upper_bound(counts + begin, counts + end + 1, k) - counts - 1);
+        return k - counts[r];
+    };
+
+    switch (type) {
+        case MoveType::REASSIGN: {
+            int r;
+            std::uint64_t s = locate(prefix_reassign.data(), l1, k, r);
+
+            // Find the target team (teams other than the origin one, in increasing order)
+            int l_target = 1;
+            while (l_target == l1 || s >= static_cast<std::uint64_t>(
+                    slot_offset[r * n_teams + l_target] - slot_offset[r * n_teams + l_target - 1])) {
+                if (l_target != l1) {
+                    s -= slot_offset[r * n_teams + l_target] - slot_offset[r * n_teams + l_target - 1];
+                }
+                ++l_target;
+            }
+
+            int idx_origin = r + first_switch - base->offset[l1];
+            return Move::reassign(l1, idx_origin, l_target, slots[slot_offset[r * n_teams + l_target - 1] + s]);
+        }
+
+        case MoveType::SWAP: {
+            const std::uint64_t* prefix1 = prefix.data() + (l2 - 1) * stride;
+            const std::uint64_t* prefix2 = prefix.data() + (l1 - 1) * stride;
+            std::uint64_t count2 = prefix2[base->offset[l2 + 1] - first_switch] -
+                    prefix2[base->offset[l2] - first_switch];
+
+            int r1, r2;
+            std::uint64_t s1 = locate(prefix1, l1, k / count2, r1);
+            std::uint64_t s2 = locate(prefix2, l2, k % count2, r2);
+            int idx1 = r1 + first_switch - base->offset[l1];
+            int idx2 = r2 + first_switch - base->offset[l2];
+            int slot1 = slots[slot_offset[r1 * n_teams + l2 - 1] + s1];
+            int slot2 = slots[slot_offset[r2 * n_teams + l1 - 1] + s2];
+
+            // The slots refer to the base sequences, which still contain the other
+            // switch (the two slots around it lead to the same move)
+            return Move::swap(l1, idx1, (slot1 > idx2 ? slot1 - 1 : slot1),
+                    l2, idx2, (slot2 > idx1 ? slot2 - 1 : slot2));
+        }
+
+        default:
+            return Move();
+    }
+}
@@ -0,0 +1,301 @@
+#ifndef MANEUVERS_SCHEDULING_MOVE_H
+#define MANEUVERS_SCHEDULING_MOVE_H
+
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+#include "candidate_lists.h"
+#include "dont_look_bits.h"
+#include "evaluator.h"
+#include "flat_schedule.h"
+#include "move_filter.h"
+#include "problem.h"
+#include "segment_data.h"
+
+
+namespace orcs {
+
+    /**
+     * Types of moves performed by the neighborhoods. Pair swaps are the swaps in
+     * which each switch takes the position of the other one (see Move::pair_swap).
+     */
+    enum class MoveType {
+        SHIFT,
+        REASSIGN,
+        SWAP,
+        PAIR_SWAP,
+        OR_OPT,
+        TAIL_EXCHANGE
+    };
+
+    /**
+     * Number of types of moves (e.g., layers of the don't-look bits, see
+     * Move::involves).
+     */
+    static constexpr int MOVE_TYPES = static_cast<int>(MoveType::TAIL_EXCHANGE) + 1;
+
+    /**
+     * A move of a neighborhood, described by the positions it changes in a base
+     * schedule. A move is applied to a working copy of the base schedule and
+     * undone after its evaluation, so the neighbors of a schedule are evaluated
+     * without copying it. Positions refer to the sequences of the base schedule.
+     */
+    class Move {
+
+    public:
+
+        /**
+         * Create a move that shifts the switch at position idx_origin of team l to
+         * position idx_target of the same team.
+         */
+        static Move shift(int l, int idx_origin, int idx_target);
+
+        /**
+         * Create a move that reassigns the switch at position idx_origin of team
+         * l_origin to position idx_target of team l_target.
+         */
+        static Move reassign(int l_origin, int idx_origin, int l_target, int idx_target);
+
+        /**
+         * Create a move that exchanges the switch at position idx1 of team l1 and the
+         * switch at position idx2 of team l2. The first one is inserted at position
+         * target1 of team l2 and the second one at position target2 of team l1.
+         */
+        static Move swap(int l1, int idx1, int target1, int l2, int idx2, int target2);
+
+        /**
+         * Create a move that exchanges the switch at position idx1 of team l1 and the
+         * switch at position idx2 of team l2 in place, i.e., each one takes the
+         * position of the other one. It is applied, evaluated and priced as a swap
+         * with targets idx2 and idx1.
+         */
+        static Move pair_swap(int l1, int idx1, int l2, int idx2);
+
+        /**
+         * Create a move that moves the segment of the given length that starts at
+         * position idx_origin of team l_origin to position idx_target of team
+         * l_target (which may be l_origin). The target position refers to the
+         * sequence of team l_target without the segment.
+         */
+        static Move or_opt(int l_origin, int idx_origin, int length, int l_target, int idx_target);
+
+        /**
+         * Create a move that exchanges the tails of the sequences of teams l1 and l2
+         * from positions idx1 and idx2, respectively (2-opt*).
+         */
+        static Move tail_exchange(int l1, int idx1, int l2, int idx2);
+
+        /**
+         * Constructor. Creates an empty move.
+         */
+        Move() = default;
+
+        /**
+         * Check whether the move passes the move filter (i.e., it does not certainly
+         * lead to an infeasible schedule).
+         *
+         * @param   filter
+         *          The move filter, loaded with the base schedule.
+         * @param   base
+         *          The base schedule.
+         * @return  False if the move certainly leads to an infeasible schedule, true
+         *          otherwise.
+         */
+        bool accept(const MoveFilter& filter, const FlatSchedule& base) const;
+
+        /**
+         * Check whether the move changes the neighbors of an active switch (see
+         * DontLookBits), i.e., whether a switch moved or a switch next to the
+         * positions the switches leave or enter is active. The bits are taken from
+         * the layer of the type of the move.
+         *
+         * @param   dont_look
+         *          The don't-look bits.
+         * @param   base
+         *          The base schedule.
+         * @return  True if a switch whose neighbors change is active, false otherwise.
+         */
+        bool involves(const DontLookBits& dont_look, const FlatSchedule& base) const;
+
+        /**
+         * Check whether the move changes the position of a switch in the critical
+         * path of the base schedule (see DeltaEvaluator::find_critical_path).
+         *
+         * @param   evaluator
+         *          The incremental evaluator, loaded with the base schedule, whose
+         *          critical path has been found.
+         * @param   base
+         *          The base schedule.
+         * @return  True if a switch moved is critical, false otherwise.
+         */
+        bool touches(const DeltaEvaluator& evaluator, const FlatSchedule& base) const;
+
+        /**
+         * Price the move without applying it (see SegmentData). Only swaps, segment
+         * moves and tail exchanges are priced; for other moves, the lower bound is
+         * zero.
+         *
+         * @param   segments
+         *          The segment data, loaded with the base schedule.
+         * @param   makespan
+         *          The makespan of the neighbor, if the price is exact, or a lower
+         *          bound on it, otherwise.
+         * @return  True if the price is exact (in which case the neighbor is
+         *          feasible), false otherwise.
+         */
+        bool price(const SegmentData& segments, double& makespan) const;
+
+        /**
+         * Apply the move to a schedule equal to the base schedule.
+         */
+        void apply(FlatSchedule& schedule) const;
+
+        /**
+         * Undo the move on a schedule to which it has been applied.
+         */
+        void undo(FlatSchedule& schedule) const;
+
+        /**
+         * Evaluate a schedule to which the move has been applied.
+         *
+         * @param   evaluator
+         *          The incremental evaluator, loaded with the base schedule.
+         * @param   schedule
+         *          The schedule to which the move has been applied.
+         * @param   makespan
+         *          The makespan of the schedule (see DeltaEvaluator::evaluate).
+         * @param   bound
+         *          Upper bound on the makespan.
+         * @return  The status of the evaluation.
+         */
+        EvaluationStatus evaluate(DeltaEvaluator& evaluator, const FlatSchedule& schedule, double& makespan,
+                double bound = std::numeric_limits<double>::max()) const;
+
+        /**
+         * Build the neighbor obtained by the move. The move is applied to the working
+         * schedule (which must be equal to the base schedule), which is left with the
+         * neighbor.
+         *
+         * @param   evaluator
+         *          The incremental evaluator, loaded with the base schedule.
+         * @param   schedule
+         *          The working schedule.
+         * @return  A tuple of two elements, in which the first is the
+         *          schedule and the second is the makespan.
+         */
+        std::tuple<Schedule, double> materialize(DeltaEvaluator& evaluator, FlatSchedule& schedule) const;
+
+        // Team and position of the (first) switch moved and its target position (in
+        // team l2 for reassignments, swaps and segment moves, or in team l1 for
+        // shifts). For swaps, the same attributes of the second switch (whose target
+        // is in team l1). For segment moves, the number of switches moved. For tail
+        // exchanges, the teams and the first positions of their tails.
+        MoveType type = MoveType::SHIFT;
+        int l1 = 0;
+        int idx1 = 0;
+        int length = 1;
+        int target1 = 0;
+        int l2 = -1;
+        int idx2 = -1;
+        int target2 = -1;
+
+    private:
+
+        // Check whether a predicate holds for a switch moved (or, for tail exchanges,
+        // for a switch around the cut points)
+        template <class Predicate>
+        bool any_switch(const FlatSchedule& base, Predicate predicate) const;
+
+        // Check whether a predicate holds for a switch next to the positions the
+        // switches moved leave or enter (other than the switches moved)
+        template <class Predicate>
+        bool any_neighbor(const FlatSchedule& base, Predicate predicate) const;
+
+    };
+
+    /**
+     * The set of all moves of a given type on a base schedule, in which each move
+     * is identified by an index from 0 to size()-1. Moves are decoded from their
+     * indexes on demand, so the moves can be visited in any order (e.g., a random
+     * permutation of the indexes) without building a list of them.
+     *
+     * If candidate lists are given, reassignments and swaps are granular: a switch
+     * is only inserted in a team right before or right after one of its candidates
+     * for that team (or at the beginning of the sequence, if the origin is one of
+     * them), so the number of moves is linear in the number of candidates instead of
+     * in the size of the sequences. Shifts are not affected.
+     */
+    class MoveSpace {
+
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param   type
+         *          The type of the moves.
+         * @param   base
+         *          The base schedule.
+         * @param   candidates
+         *          The candidate lists of the granular moves (nullptr, if all
+         *          moves must be considered).
+         */
+        MoveSpace(MoveType type, const FlatSchedule& base, const CandidateLists* candidates = nullptr);
+
+        // Lengths of the segments moved by segment moves
+        static constexpr int min_segment = 2;
+        static constexpr int max_segment = 3;
+
+        /**
+         * Return the number of moves.
+         */
+        inline std::uint64_t size() const {
+            return offset.back();
+        }
+
+        /**
+         * Return the move of index k.
+         */
+        Move operator[](std::uint64_t k) const;
+
+    private:
+
+        void load_candidates(const CandidateLists& candidates);
+
+        Move granular_move(int l1, int l2, std::uint64_t k) const;
+
+        MoveType type;
+        const FlatSchedule* base;
+        int n_teams;
+        int n_slots;
+
+        // Moves are grouped by team (shift), by origin team (reassignment), by pair
+        // of teams (swap, pair swap and tail exchange) or by origin team and length
+        // (segment move). The moves of group g have indexes from offset[g] to
+        // offset[g+1]-1.
+        std::vector<int> group_first;
+        std::vector<int> group_second;
+        std::vector<std::uint64_t> offset;
+
+        // Granular moves. The switches of teams 1 to m are numbered by their position
+        // in the giant tour (from the first switch of team 1). The positions in which
+        // switch r can be inserted in team l are slots[slot_offset[r*m+l-1]] to
+        // slots[slot_offset[r*m+l]-1]. Then, prefix[(l-1)*(N+1)+r] is the number of
+        // such positions in team l of the switches before r and prefix_reassign[r]
+        // the number of positions of the switches before r in teams other than
+        // their own one.
+        bool granular = false;
+        int first_switch = 0;
+        std::vector<int> slots;
+        std::vector<int> slot_offset;
+        std::vector<std::uint64_t> prefix;
+        std::vector<std::uint64_t> prefix_reassign;
+
+    };
+
+}
+
+
+#endif
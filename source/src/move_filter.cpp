@@ -0,0 +1,138 @@
+#include "move_filter.h"
+
+#include <algorithm>
+#include <limits>
+
+
+orcs::MoveFilter::MoveFilter(const Problem& problem) :
+        problem(&problem),
+        last_pred((problem.m + 1) * (problem.n + 1), -1),
+        first_succ((problem.m + 1) * (problem.n + 1), std::numeric_limits<int>::max()) {
+
+}
+
+void orcs::MoveFilter::load(const std::tuple<Schedule, double>& entry) {
+
+    const Schedule& schedule = std::get<Schedule>(entry);
+    const int n = problem->n;
+
+    std::fill(last_pred.begin(), last_pred.end(), -1);
+    std::fill(first_succ.begin(), first_succ.end(), std::numeric_limits<int>::max());
+
+    for (int l = 0; l <= problem->m; ++l) {
+
+        int* last = &last_pred[l * (n + 1)];
+        int* first = &first_succ[l * (n + 1)];
+
+        // Switch x at position idx is a predecessor of its transitive successors. As
+        // positions are visited in increasing order, the last one is kept.
+        for (int idx = 0; idx < static_cast<int>(schedule[l].size()); ++idx) {
+            int x = std::get<ATTR_SWITCH>(schedule[l][idx]);
+            problem->precedence_matrix.for_each(x, [last, idx](int j) {
+                last[j] = idx;
+            });
+        }
+
+        // Switch x at position idx is a successor of its transitive predecessors. As
+        // positions are visited in decreasing order, the first one is kept.
+        for (int idx = static_cast<int>(schedule[l].size()) - 1; idx >= 0; --idx) {
+            int x = std::get<ATTR_SWITCH>(schedule[l][idx]);
+            problem->precedence_matrix_transposed.for_each(x, [first, idx](int j) {
+                first[j] = idx;
+            });
+        }
+    }
+}
+
+bool orcs::MoveFilter::accept_insertion(int j, int l, int idx, int removed) const {
+    return last_predecessor(j, l, removed) < idx && first_successor(j, l, removed) >= idx;
+}
+
+bool orcs::MoveFilter::accept_exchange(int j1, int l1, int idx1, int target1,
+        int j2, int l2, int idx2, int target2) const {
+
+    // Each switch must fit the team order of its new team
+    if (!accept_insertion(j1, l2, target1, idx2) || !accept_insertion(j2, l1, target2, idx1)) {
+        return false;
+    }
+
+    // Path from j2 to j1: j2 comes before a predecessor of j1 in team l1, or a successor
+    // of j2 comes before j1 in team l2
+    bool path21 = last_predecessor(j1, l1, idx1) >= target2 ||
+                  first_successor(j2, l2, idx2) < target1;
+
+    // Path from j1 to j2: j1 comes before a predecessor of j2 in team l2, or a successor
+    // of j1 comes before j2 in team l1
+    bool path12 = last_predecessor(j2, l2, idx2) >= target1 ||
+                  first_successor(j1, l1, idx1) < target2;
+
+    // Both paths form a cycle
+    return !(path21 && path12);
+}
+
+bool orcs::MoveFilter::accept_segment(const int* segment, int length, int l_origin, int idx_origin,
+        int l_target, int idx_target) const {
+
+    const int n = problem->n;
+    for (int k = 0; k < length; ++k) {
+        int pred = last_pred[l_target * (n + 1) + segment[k]];
+        int succ = first_succ[l_target * (n + 1) + segment[k]];
+
+        // Positions refer to the sequence without the segment. If the last predecessor
+        // (first successor) is in the segment, no constraint is imposed.
+        if (l_origin == l_target) {
+            if (pred >= idx_origin) {
+                pred = (pred < idx_origin + length ? -1 : pred - length);
+            }
+
+            if (succ >= idx_origin && succ != std::numeric_limits<int>::max()) {
+                succ = (succ < idx_origin + length ? std::numeric_limits<int>::max() : succ - length);
+            }
+        }
+
+        if (pred >= idx_target || succ < idx_target) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool orcs::MoveFilter::accept_append(const int* segment, int length, int l, int idx) const {
+
+    // No switch of the segment can have a successor among the first idx switches
+    const int n = problem->n;
+    for (int k = 0; k < length; ++k) {
+        if (first_succ[l * (n + 1) + segment[k]] < idx) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int orcs::MoveFilter::last_predecessor(int j, int l, int removed) const {
+
+    int idx = last_pred[l * (problem->n + 1) + j];
+
+    // If the last predecessor is the switch removed, the position of the previous
+    // one is unknown, so no constraint is imposed
+    if (idx < 0 || idx == removed) {
+        return -1;
+    }
+
+    return (removed >= 0 && idx > removed ? idx - 1 : idx);
+}
+
+int orcs::MoveFilter::first_successor(int j, int l, int removed) const {
+
+    int idx = first_succ[l * (problem->n + 1) + j];
+
+    // If the first successor is the switch removed, the position of the next
+    // one is unknown, so no constraint is imposed
+    if (idx == std::numeric_limits<int>::max() || idx == removed) {
+        return std::numeric_limits<int>::max();
+    }
+
+    return (removed >= 0 && idx > removed ? idx - 1 : idx);
+}
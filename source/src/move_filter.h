@@ -0,0 +1,123 @@
+#ifndef MANEUVERS_SCHEDULING_MOVE_FILTER_H
+#define MANEUVERS_SCHEDULING_MOVE_FILTER_H
+
+#include <tuple>
+#include <vector>
+
+#include "problem.h"
+
+
+namespace orcs {
+
+    /**
+     * Filter that rejects, in constant time, moves that certainly lead to
+     * infeasible schedules. For a base schedule, it keeps, for each team and
+     * switch, the position of the last transitive predecessor and of the first
+     * transitive successor of the switch in the sequence of the team (computed
+     * from Problem::precedence_matrix). A switch inserted after one of its
+     * transitive successors or before one of its transitive predecessors in a
+     * sequence causes a deadlock. The filter is conservative: a move accepted
+     * by the filter may still be infeasible, but a rejected move is always
+     * infeasible. Cycles formed across the orders of two teams are only checked
+     * for exchanges (see accept_exchange); insertions, segment moves and appends
+     * are only checked against the order of the team that receives the switches,
+     * so their cross-team deadlocks are left to the evaluation.
+     */
+    class MoveFilter {
+
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param   problem
+         *          The instance of the problem the schedules belong to.
+         */
+        explicit MoveFilter(const Problem& problem);
+
+        /**
+         * Load a base schedule.
+         *
+         * @param   entry
+         *          The base schedule.
+         */
+        void load(const std::tuple<Schedule, double>& entry);
+
+        /**
+         * Check whether switch j can be inserted at position idx of the sequence of
+         * team l. The position refers to the sequence of team l of the base schedule
+         * after the removal of the switch at position removed.
+         *
+         * @param   j
+         *          The switch to insert.
+         * @param   l
+         *          The team.
+         * @param   idx
+         *          The position of insertion.
+         * @param   removed
+         *          Position of the sequence of team l from which a switch has been
+         *          removed (-1, if none).
+         * @return  False if the insertion certainly leads to an infeasible schedule,
+         *          true otherwise.
+         */
+        bool accept_insertion(int j, int l, int idx, int removed = -1) const;
+
+        /**
+         * Check whether the exchange of switches j1 (at position idx1 of team l1) and
+         * j2 (at position idx2 of team l2) can be performed, in which j1 is inserted at
+         * position target1 of team l2 and j2 is inserted at position target2 of team l1
+         * (positions refer to the sequences without the exchanged switches). Besides
+         * the insertions themselves, it checks cross-team cycles formed by the team
+         * orders of l1 and l2 (e.g., j2 comes before a predecessor of j1 in team l1,
+         * while j1 comes before a predecessor of j2 in team l2).
+         *
+         * @return  False if the exchange certainly leads to an infeasible schedule,
+         *          true otherwise.
+         */
+        bool accept_exchange(int j1, int l1, int idx1, int target1,
+                int j2, int l2, int idx2, int target2) const;
+
+        /**
+         * Check whether the segment of the given length at position idx_origin of
+         * team l_origin can be moved to position idx_target of team l_target (which
+         * refers to the sequence of team l_target without the segment, as in
+         * FlatSchedule::move).
+         *
+         * @param   segment
+         *          The switches of the segment.
+         * @return  False if the move certainly leads to an infeasible schedule,
+         *          true otherwise.
+         */
+        bool accept_segment(const int* segment, int length, int l_origin, int idx_origin,
+                int l_target, int idx_target) const;
+
+        /**
+         * Check whether the given segment (from another team) can be appended to the
+         * first idx switches of the sequence of team l.
+         *
+         * @param   segment
+         *          The switches of the segment.
+         * @return  False if the move certainly leads to an infeasible schedule,
+         *          true otherwise.
+         */
+        bool accept_append(const int* segment, int length, int l, int idx) const;
+
+    private:
+
+        int last_predecessor(int j, int l, int removed) const;
+
+        int first_successor(int j, int l, int removed) const;
+
+        const Problem* problem;
+
+        // Position of the last transitive predecessor and of the first transitive
+        // successor of each switch in each team (indexed by l * (n + 1) + j)
+        std::vector<int> last_pred;
+        std::vector<int> first_succ;
+
+    };
+
+}
+
+
+#endif
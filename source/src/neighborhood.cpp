@@ -1,478 +1,522 @@
 #include "neighborhood.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
 #include <limits>
 #include <vector>
 
+#include "flat_schedule.h"
+#include "move.h"
+#include "search_context.h"
 #include "utils.h"
 
 
-std::tuple<orcs::Schedule, double> orcs::Shift::best_improvement(const orcs::Problem& problem,
-        const std::tuple<orcs::Schedule, double>& entry) {
-
-    // Keep the best neighbor
-    std::tuple<Schedule, double> best_neighbor = entry;
-
-    // Evaluate all neighbors
-    for (int l = 0; l <= problem.m; ++l) {
-        for (int idx_origin = 0; idx_origin < std::get<Schedule>(entry)[l].size(); ++idx_origin) {
+void orcs::NeighborhoodStatistics::start_search() {
+    timer.reset();
+    timer.start();
+}
 
-            // Create a copy as base to perform movements
-            Schedule base_schedule = std::get<Schedule>(entry);
-            Maneuver maneuver = base_schedule[l][idx_origin];
-            base_schedule[l].erase(base_schedule[l].begin() + idx_origin);
+void orcs::NeighborhoodStatistics::stop_search(bool improving) {
+    timer.stop();
+    time += timer.count<std::chrono::microseconds>() / 1000000.0;
+    ++searches;
+    if (improving) {
+        ++this->improving;
+    }
+}
 
-            // Evaluate neighbor solutions
-            for (int idx_target = 0; idx_target <= base_schedule[l].size(); ++idx_target) {
-                if (idx_target != idx_origin) {
+void orcs::NeighborhoodStatistics::add(const NeighborhoodStatistics& other) {
+    searches += other.searches;
+    improving += other.improving;
+    time += other.time;
+    generated += other.generated;
+    rejected += other.rejected;
+    evaluated += other.evaluated;
+    priced += other.priced;
+}
 
-                    Schedule current_schedule = base_schedule;
-                    current_schedule[l].insert(current_schedule[l].begin() + idx_target, maneuver);
+void orcs::NeighborhoodStatistics::report(const std::string& name, cxxproperties::Properties* opt_output) const {
+    opt_output->add(name + " - searches", searches);
+    opt_output->add(name + " - improving neighbors found", improving);
+    opt_output->add(name + " - moves generated", generated);
+    opt_output->add(name + " - moves rejected as infeasible", rejected);
+    opt_output->add(name + " - moves evaluated", evaluated);
+    opt_output->add(name + " - moves priced exactly", priced);
+    opt_output->add(name + " - time (s)", time);
+}
 
-                    std::tuple<Schedule, double> neighbor = std::make_tuple(std::move(current_schedule), 0.0);
-                    bool is_feasible = orcs::utils::evaluate(problem, neighbor);
 
-                    // Check if the current neighbor is better
-                    if (is_feasible) {
-                        if (std::get<double>(neighbor) < std::get<double>(best_neighbor)) {
-                            best_neighbor = std::move(neighbor);
-                        }
-                    }
-                }
-            }
+/**
+ * Check whether the moves of a type are priced from the segment data (see
+ * Move::price).
+ */
+static bool is_priced(orcs::MoveType type) {
+    return (type == orcs::MoveType::SWAP || type == orcs::MoveType::PAIR_SWAP ||
+            type == orcs::MoveType::OR_OPT || type == orcs::MoveType::TAIL_EXCHANGE);
+}
 
+/**
+ * Scan the moves of a move space, whose indexes are claimed in chunks (in increasing
+ * order) from a shared counter, and keep the best one (lowest makespan and, among
+ * those, lowest index). The entry must be loaded in the context. The scan stops
+ * early if the deadline (if any) expires.
+ */
+static void scan_moves(orcs::SearchContext& context, const orcs::MoveSpace& movements,
+        const orcs::DontLookBits& dont_look, const orcs::DeltaEvaluator* critical, const orcs::Deadline* deadline,
+        std::atomic<std::uint64_t>& next, double& best_makespan, std::uint64_t& best_index,
+        orcs::NeighborhoodStatistics& statistics) {
+
+    orcs::DeltaEvaluator& evaluator = context.delta;
+    orcs::MoveFilter& filter = context.filter;
+
+    // Moves are applied to and undone on a working copy of the base schedule
+    const orcs::FlatSchedule& base = evaluator.base();
+    orcs::FlatSchedule& working = context.working;
+    working = base;
+
+    // As the chunks of a worker are claimed in increasing order, the first move that
+    // reaches the best makespan of a worker has the lowest index among its moves
+    const std::uint64_t chunk = 64;
+    for (std::uint64_t first = next.fetch_add(chunk); first < movements.size(); first = next.fetch_add(chunk)) {
+
+        // The deadline is polled once per chunk
+        if (deadline != nullptr && deadline->expired()) {
+            break;
         }
-    }
-
-    // Return the best neighbor
-    return best_neighbor;
-}
 
-std::tuple<orcs::Schedule, double> orcs::Shift::first_improvement(const orcs::Problem& problem,
-        const std::tuple<orcs::Schedule, double>& entry, std::mt19937& generator) {
+        std::uint64_t last = std::min(first + chunk, movements.size());
+        statistics.generated += static_cast<long>(last - first);
+        for (std::uint64_t k = first; k < last; ++k) {
 
-    // Create a list of all possible movements
-    std::vector< std::tuple<int, int, int> > movements;
-    for (int l = 0; l <= problem.m; ++l) {
-        for (int idx_origin = 0; idx_origin < std::get<Schedule>(entry)[l].size(); ++idx_origin) {
-            for (int idx_target = 0; idx_target <= std::get<Schedule>(entry)[l].size() - 1; ++idx_target) {
-                if (idx_target != idx_origin) {
-                    movements.emplace_back(l, idx_origin, idx_target);
-                }
+            // Skip movements of inactive (or non-critical, if restricted to the critical
+            // path) switches and movements that certainly lead to infeasible schedules
+            orcs::Move move = movements[k];
+            if (!move.involves(dont_look, base) || (critical != nullptr && !move.touches(*critical, base))) {
+                continue;
             }
-        }
-    }
-
-    // Shuffle the list of possible movements
-    std::shuffle(movements.begin(), movements.end(), generator);
 
-    // Keep the best neighbor
-    std::tuple<Schedule, double> best_neighbor = entry;
+            if (!move.accept(filter, base)) {
+                ++statistics.rejected;
+                continue;
+            }
 
-    // Evaluate neighbors until find a first one that improves the objective function
-    for (const auto& movement : movements) {
+            // Price the movement in constant time, if possible, and skip it if its
+            // lower bound reaches the best makespan. Otherwise, evaluate it.
+            double makespan;
+            orcs::EvaluationStatus status = orcs::EvaluationStatus::FEASIBLE;
+            if (move.price(context.segments, makespan)) {
+                ++statistics.priced;
 
-        // Get the attributes of the movemnt
-        int l, idx_origin, idx_target;
-        std::tie(l, idx_origin, idx_target) = movement;
+            } else {
+                if (makespan >= best_makespan) {
+                    continue;
+                }
 
-        // Evalutate the movement
-        Schedule current_schedule = std::get<Schedule>(entry);
-        Maneuver maneuver = current_schedule[l][idx_origin];
-        current_schedule[l].erase(current_schedule[l].begin() + idx_origin);
-        current_schedule[l].insert(current_schedule[l].begin() + idx_target, maneuver);
+                move.apply(working);
+                status = move.evaluate(evaluator, working, makespan, best_makespan);
+                move.undo(working);
 
-        std::tuple<Schedule, double> neighbor = std::make_tuple(std::move(current_schedule), 0.0);
-        bool is_feasible = orcs::utils::evaluate(problem, neighbor);
+                ++statistics.evaluated;
+                if (status == orcs::EvaluationStatus::INFEASIBLE) {
+                    ++statistics.rejected;
+                }
+            }
 
-        // Check if the current neighbor is better
-        if (is_feasible) {
-            if (std::get<double>(neighbor) < std::get<double>(best_neighbor)) {
-                best_neighbor = std::move(neighbor);
-                break;
+            // Check if the current neighbor is better
+            if (status == orcs::EvaluationStatus::FEASIBLE && makespan < best_makespan) {
+                best_makespan = makespan;
+                best_index = k;
             }
         }
-
     }
-
-    // Return the first improvement neighbor
-    return best_neighbor;
 }
 
-std::tuple<orcs::Schedule, double> orcs::Shift::shake(const orcs::Problem& problem,
-        const std::tuple<orcs::Schedule, double>& entry, bool feasible_only,
-        std::mt19937& generator) {
+/**
+ * Make inactive, in the layer of a type of moves, the switches whose moves have all
+ * been examined without finding an improvement: all switches or, if the moves are
+ * restricted to the critical path, the switches in it. Nothing is done if the
+ * deadline has expired, since the search may have stopped early.
+ */
+static void deactivate_examined(orcs::SearchContext& context, orcs::MoveType type, bool critical_only) {
+    if (!context.dont_look.enabled() || context.expired()) {
+        return;
+    }
 
-    // Create a list of all possible movements
-    std::vector< std::tuple<int, int, int> > movements;
-    for (int l = 0; l <= problem.m; ++l) {
-        for (int idx_origin = 0; idx_origin < std::get<Schedule>(entry)[l].size(); ++idx_origin) {
-            for (int idx_target = 0; idx_target <= std::get<Schedule>(entry)[l].size() - 1; ++idx_target) {
-                if (idx_target != idx_origin) {
-                    movements.emplace_back(l, idx_origin, idx_target);
-                }
-            }
+    int layer = static_cast<int>(type);
+    if (critical_only) {
+        for (auto j : context.delta.critical_path()) {
+            context.dont_look.deactivate(layer, j);
         }
+    } else {
+        context.dont_look.deactivate(layer);
     }
+}
 
-    // Shuffle the list of possible movements
-    std::shuffle(movements.begin(), movements.end(), generator);
+std::tuple<orcs::Schedule, double> orcs::Neighborhood::best_move(const std::tuple<orcs::Schedule, double>& entry,
+        orcs::MoveType type, orcs::SearchContext& context, const orcs::CandidateLists* candidates,
+        bool critical_only) {
 
-    // Keep the neighbor obtained by the shake movement
-    std::tuple<Schedule, double> shaked = entry;
+    // Load the entry as base of the incremental evaluation and of the move filter
+    DeltaEvaluator& evaluator = context.delta;
+    bool feasible = evaluator.load(entry);
 
-    // Evaluate neighbors until find a first one that improves the objective function
-    for (const auto& movement : movements) {
+    MoveFilter& filter = context.filter;
+    filter.load(entry);
 
-        // Get the attributes of the movement
-        int l, idx_origin, idx_target;
-        std::tie(l, idx_origin, idx_target) = movement;
+    // Swaps, segment moves and tail exchanges are priced from the segment data of
+    // the entry
+    bool priced = is_priced(type);
+    if (priced) {
+        context.segments.load(evaluator.base(), feasible);
+    }
 
-        // Evaluate the movement
-        Schedule current_schedule = std::get<Schedule>(entry);
-        Maneuver maneuver = current_schedule[l][idx_origin];
-        current_schedule[l].erase(current_schedule[l].begin() + idx_origin);
-        current_schedule[l].insert(current_schedule[l].begin() + idx_target, maneuver);
+    // Moves may be restricted to the ones that change the critical path
+    const DeltaEvaluator* critical = nullptr;
+    if (critical_only) {
+        evaluator.find_critical_path();
+        critical = &evaluator;
+    }
 
-        std::tuple<Schedule, double> neighbor = std::make_tuple(std::move(current_schedule), 0.0);
-        bool is_feasible = orcs::utils::evaluate(problem, neighbor);
+    MoveSpace movements(type, evaluator.base(), candidates);
+    std::atomic<std::uint64_t> next(0);
+
+    // Keep the best move (no move found yet)
+    const std::uint64_t none = std::numeric_limits<std::uint64_t>::max();
+    double best_makespan = std::get<double>(entry);
+    std::uint64_t best_index = none;
+
+    // Small neighborhoods are not worth waking up the workers
+    const std::uint64_t min_parallel_moves = 1024;
+    if (context.pool == nullptr || context.pool->size() == 1 || movements.size() < min_parallel_moves) {
+        scan_moves(context, movements, context.dont_look, critical, context.deadline, next,
+                best_makespan, best_index, statistics);
+
+    } else {
+
+        // Each worker keeps its own best move and counters, using its own workspace
+        std::vector<double> worker_makespan(context.pool->size(), best_makespan);
+        std::vector<std::uint64_t> worker_index(context.pool->size(), none);
+        std::vector<NeighborhoodStatistics> worker_statistics(context.pool->size());
+
+        context.pool->run([&](int worker) {
+            SearchContext& worker_context = (worker == 0 ? context : *context.workers[worker]);
+            if (worker != 0) {
+                bool worker_feasible = worker_context.delta.load(entry);
+                worker_context.filter.load(entry);
+                if (priced) {
+                    worker_context.segments.load(worker_context.delta.base(), worker_feasible);
+                }
+            }
 
-        // Check if the current neighbor is better
-        if (is_feasible || !feasible_only) {
-            shaked = std::move(neighbor);
-            break;
+            scan_moves(worker_context, movements, context.dont_look, critical, context.deadline, next,
+                    worker_makespan[worker], worker_index[worker], worker_statistics[worker]);
+        });
+
+        // Deterministic reduction: lowest makespan and, among ties, lowest index
+        for (int worker = 0; worker < context.pool->size(); ++worker) {
+            statistics.add(worker_statistics[worker]);
+            if (worker_index[worker] != none && (worker_makespan[worker] < best_makespan ||
+                    (worker_makespan[worker] == best_makespan && worker_index[worker] < best_index))) {
+                best_makespan = worker_makespan[worker];
+                best_index = worker_index[worker];
+            }
         }
+    }
 
+    // Return the best neighbor (only the best move is materialized)
+    if (best_index == none) {
+        deactivate_examined(context, type, critical_only);
+        return entry;
     }
 
-    // Return the first improvement neighbor
-    return shaked;
+    context.working = evaluator.base();
+    return movements[best_index].materialize(evaluator, context.working);
 }
 
+std::tuple<orcs::Schedule, double> orcs::Neighborhood::first_move(const std::tuple<orcs::Schedule, double>& entry,
+        orcs::MoveType type, orcs::SearchContext& context, std::mt19937& generator,
+        const orcs::CandidateLists* candidates, bool critical_only) {
 
-std::tuple<orcs::Schedule, double> orcs::Reassignement::best_improvement(const orcs::Problem& problem,
-        const std::tuple<orcs::Schedule, double>& entry) {
-
-    // Keep the best neighbor
-    std::tuple<Schedule, double> best_neighbor = entry;
-
-    // Evaluate all neighbors
-    for (int l_origin = 1; l_origin <= problem.m; ++l_origin) {
-        for (int idx_origin = 0; idx_origin < std::get<Schedule>(entry)[l_origin].size(); ++idx_origin) {
+    // Load the entry as base of the incremental evaluation and of the move filter
+    DeltaEvaluator& evaluator = context.delta;
+    bool feasible = evaluator.load(entry);
 
-            // Create a base schedule
-            Schedule base_schedule = std::get<Schedule>(entry);
-            Maneuver operation = base_schedule[l_origin][idx_origin];
-            base_schedule[l_origin].erase(base_schedule[l_origin].begin() + idx_origin);
+    MoveFilter& filter = context.filter;
+    filter.load(entry);
 
-            // Try neighbor solutions
-            for (int l_target = 1; l_target <= problem.m; ++l_target) {
-                if (l_target != l_origin) {
-                    for (int idx_target = 0; idx_target <= base_schedule[l_target].size(); ++idx_target) {
-
-                        Schedule current_schedule = base_schedule;
-                        current_schedule[l_target].insert(current_schedule[l_target].begin() + idx_target, operation);
-
-                        std::tuple<Schedule, double> neighbor = std::make_tuple(std::move(current_schedule), 0.0);
-                        bool is_feasible = orcs::utils::evaluate(problem, neighbor);
-
-                        // Check if the current neighbor is better
-                        if (is_feasible) {
-                            if (std::get<double>(neighbor) < std::get<double>(best_neighbor)) {
-                                best_neighbor = std::move(neighbor);
-                            }
-                        }
-                    }
-                }
-            }
+    // Swaps, segment moves and tail exchanges are priced from the segment data of
+    // the entry
+    if (is_priced(type)) {
+        context.segments.load(evaluator.base(), feasible);
+    }
 
-        }
+    // Moves may be restricted to the ones that change the critical path
+    if (critical_only) {
+        evaluator.find_critical_path();
     }
 
-    // Return the best neighbor
-    return best_neighbor;
-}
+    // Moves are applied to and undone on a working copy of the base schedule
+    const FlatSchedule& base = evaluator.base();
+    FlatSchedule& working = context.working;
+    working = base;
 
-std::tuple<orcs::Schedule, double> orcs::Reassignement::first_improvement(const orcs::Problem& problem,
-        const std::tuple<orcs::Schedule, double>& entry, std::mt19937& generator) {
+    // Visit the movements in random order (they are generated on demand)
+    MoveSpace movements(type, base, candidates);
+    utils::RandomPermutation order(movements.size(), generator);
 
-    // Create a list of all possible movements
-    std::vector< std::tuple<int, int, int, int> > movements;
-    for (int l_origin = 1; l_origin <= problem.m; ++l_origin) {
-        for (int idx_origin = 0; idx_origin < std::get<Schedule>(entry)[l_origin].size(); ++idx_origin) {
-            for (int l_target = 1; l_target <= problem.m; ++l_target) {
-                if (l_target != l_origin) {
-                    for (int idx_target = 0; idx_target <= std::get<Schedule>(entry)[l_target].size(); ++idx_target) {
-                        movements.emplace_back(l_origin, idx_origin, l_target, idx_target);
-                    }
-                }
-            }
+    // Evaluate neighbors until find a first one that improves the objective function
+    // (or the deadline expires, which is polled every 64 moves)
+    for (std::uint64_t k = 0; k < movements.size(); ++k) {
+        if (k % 64 == 0 && context.expired()) {
+            break;
         }
-    }
 
-    // Shuffle the list of possible movements
-    std::shuffle(movements.begin(), movements.end(), generator);
+        Move move = movements[order(k)];
+        ++statistics.generated;
 
-    // Keep the best neighbor
-    std::tuple<Schedule, double> best_neighbor = entry;
+        // Skip movements of inactive (or non-critical, if restricted to the critical path)
+        // switches and movements that certainly lead to infeasible schedules
+        if (!move.involves(context.dont_look, base) || (critical_only && !move.touches(evaluator, base))) {
+            continue;
+        }
 
-    // Evaluate neighbors until find a first one that improves the objective function
-    for (const auto& movement : movements) {
+        if (!move.accept(filter, base)) {
+            ++statistics.rejected;
+            continue;
+        }
 
-        // Get the attributes of the movemnt
-        int l_origin, idx_origin, l_target, idx_target;
-        std::tie(l_origin, idx_origin, l_target, idx_target) = movement;
+        // Price the movement in constant time, if possible, and skip it if its lower
+        // bound reaches the makespan of the entry
+        double makespan;
+        move.price(context.segments, makespan);
+        if (makespan >= std::get<double>(entry)) {
+            continue;
+        }
 
-        // Evalutate the movement
-        Schedule current_schedule = std::get<Schedule>(entry);
-        Maneuver maneuver = current_schedule[l_origin][idx_origin];
-        current_schedule[l_origin].erase(current_schedule[l_origin].begin() + idx_origin);
-        current_schedule[l_target].insert(current_schedule[l_target].begin() + idx_target, maneuver);
+        // Evaluate the movement (even if priced exactly, since the moments of the
+        // neighbor are stored)
+        move.apply(working);
+        EvaluationStatus status = move.evaluate(evaluator, working, makespan, std::get<double>(entry));
 
-        std::tuple<Schedule, double> neighbor = std::make_tuple(std::move(current_schedule), 0.0);
-        bool is_feasible = orcs::utils::evaluate(problem, neighbor);
+        ++statistics.evaluated;
+        if (status == EvaluationStatus::INFEASIBLE) {
+            ++statistics.rejected;
+        }
 
         // Check if the current neighbor is better
-        if (is_feasible) {
-            if (std::get<double>(neighbor) < std::get<double>(best_neighbor)) {
-                best_neighbor = std::move(neighbor);
-                break;
-            }
+        if (status == EvaluationStatus::FEASIBLE && makespan < std::get<double>(entry)) {
+            evaluator.store(working);
+            return std::make_tuple(working.to_schedule(), makespan);
         }
+
+        move.undo(working);
     }
 
-    // Return the first improvement neighbor
-    return best_neighbor;
+    // No neighbor improves the entry
+    deactivate_examined(context, type, critical_only);
+    return entry;
 }
 
-std::tuple<orcs::Schedule, double> orcs::Reassignement::shake(const orcs::Problem& problem,
-        const std::tuple<orcs::Schedule, double>& entry, bool feasible_only,
-        std::mt19937& generator) {
-
-    // Create a list of all possible movements
-    std::vector< std::tuple<int, int, int, int> > movements;
-    for (int l_origin = 1; l_origin <= problem.m; ++l_origin) {
-        for (int idx_origin = 0; idx_origin < std::get<Schedule>(entry)[l_origin].size(); ++idx_origin) {
-            for (int l_target = 1; l_target <= problem.m; ++l_target) {
-                if (l_target != l_origin) {
-                    for (int idx_target = 0; idx_target <= std::get<Schedule>(entry)[l_target].size(); ++idx_target) {
-                        movements.emplace_back(l_origin, idx_origin, l_target, idx_target);
-                    }
-                }
-            }
-        }
-    }
+std::tuple<orcs::Schedule, double> orcs::Neighborhood::shake_move(const std::tuple<orcs::Schedule, double>& entry,
+        orcs::MoveType type, bool feasible_only, orcs::SearchContext& context, std::mt19937& generator) {
 
-    // Shuffle the list of possible movements
-    std::shuffle(movements.begin(), movements.end(), generator);
+    // Load the entry as base of the incremental evaluation and of the move filter
+    DeltaEvaluator& evaluator = context.delta;
+    evaluator.load(entry);
 
-    // Keep the neighbor obtained by the shake movement
-    std::tuple<Schedule, double> shaked = entry;
+    MoveFilter& filter = context.filter;
+    filter.load(entry);
 
-    // Evaluate neighbors until find a first one that improves the objective function
-    for (const auto& movement : movements) {
+    // Moves are applied to and undone on a working copy of the base schedule
+    const FlatSchedule& base = evaluator.base();
+    FlatSchedule& working = context.working;
+    working = base;
 
-        // Get the attributes of the movemnt
-        int l_origin, idx_origin, l_target, idx_target;
-        std::tie(l_origin, idx_origin, l_target, idx_target) = movement;
+    // Visit the movements in random order (they are generated on demand)
+    MoveSpace movements(type, base);
+    utils::RandomPermutation order(movements.size(), generator);
 
-        // Evalutate the movement
-        Schedule current_schedule = std::get<Schedule>(entry);
-        Maneuver maneuver = current_schedule[l_origin][idx_origin];
-        current_schedule[l_origin].erase(current_schedule[l_origin].begin() + idx_origin);
-        current_schedule[l_target].insert(current_schedule[l_target].begin() + idx_target, maneuver);
+    // Perform the first movement that leads to a feasible neighbor (or the first one, if
+    // infeasible neighbors are allowed)
+    for (std::uint64_t k = 0; k < movements.size(); ++k) {
+        Move move = movements[order(k)];
 
-        std::tuple<Schedule, double> neighbor = std::make_tuple(std::move(current_schedule), 0.0);
-        bool is_feasible = orcs::utils::evaluate(problem, neighbor);
+        // Skip movements that certainly lead to infeasible schedules
+        if (feasible_only && !move.accept(filter, base)) {
+            continue;
+        }
 
-        // Check if the current neighbor is better
-        if (is_feasible || !feasible_only) {
-            shaked = std::move(neighbor);
-            break;
+        // Evaluate the movement
+        double makespan;
+        move.apply(working);
+        EvaluationStatus status = move.evaluate(evaluator, working, makespan);
+
+        if (status == EvaluationStatus::FEASIBLE) {
+            evaluator.store(working);
+            return std::make_tuple(working.to_schedule(), makespan);
+        } else if (!feasible_only) {
+            return std::make_tuple(working.to_schedule(), makespan);
         }
 
+        move.undo(working);
     }
 
-    // Return the first improvement neighbor
-    return shaked;
+    // No movement is possible
+    return entry;
 }
 
 
-std::tuple<orcs::Schedule, double> orcs::Swap::best_improvement(const orcs::Problem& problem,
-        const std::tuple<orcs::Schedule, double>& entry) {
+orcs::Shift::Shift(bool critical_only) :
+        critical_only(critical_only) {
 
-    // Keep the best neighbor
-    std::tuple<Schedule, double> best_neighbor = entry;
+}
 
-    // Evaluate all neighbors
-    for (int l1 = 1; l1 <= problem.m; ++l1) {
-        if (std::get<Schedule>(entry)[l1].size() > 0) {
-            for (int l2 = l1 + 1; l2 <= problem.m; ++l2) {
-                if (std::get<Schedule>(entry)[l2].size() > 0) {
-                    for (int idx1 = 0; idx1 < std::get<Schedule>(entry)[l1].size(); ++idx1) {
-                        for (int idx2 = 0; idx2 < std::get<Schedule>(entry)[l2].size(); ++idx2) {
-                            for (int target1 = 0; target1 <= std::get<Schedule>(entry)[l2].size() - 1; ++target1) {
-                                for (int target2 = 0; target2 <= std::get<Schedule>(entry)[l1].size() - 1; ++target2) {
+std::string orcs::Shift::name() const {
+    return "Shift";
+}
 
-                                    Schedule current_schedule = std::get<Schedule>(entry);
+std::tuple<orcs::Schedule, double> orcs::Shift::best_improvement(const orcs::Problem&,
+        const std::tuple<orcs::Schedule, double>& entry, orcs::SearchContext& context) {
+    return best_move(entry, MoveType::SHIFT, context, nullptr, critical_only);
+}
 
-                                    Maneuver maneuver1 = current_schedule[l1][idx1];
-                                    current_schedule[l1].erase(current_schedule[l1].begin() + idx1);
+std::tuple<orcs::Schedule, double> orcs::Shift::first_improvement(const orcs::Problem&,
+        const std::tuple<orcs::Schedule, double>& entry, orcs::SearchContext& context,
+        std::mt19937& generator) {
+    return first_move(entry, MoveType::SHIFT, context, generator, nullptr, critical_only);
+}
 
-                                    Maneuver maneuver2 = current_schedule[l2][idx2];
-                                    current_schedule[l2].erase(current_schedule[l2].begin() + idx2);
+std::tuple<orcs::Schedule, double> orcs::Shift::shake(const orcs::Problem&,
+        const std::tuple<orcs::Schedule, double>& entry, bool feasible_only,
+        orcs::SearchContext& context, std::mt19937& generator) {
+    return shake_move(entry, MoveType::SHIFT, feasible_only, context, generator);
+}
 
-                                    current_schedule[l2].insert(current_schedule[l2].begin() + target1, maneuver1);
-                                    current_schedule[l1].insert(current_schedule[l1].begin() + target2, maneuver2);
 
-                                    std::tuple<Schedule, double> neighbor = std::make_tuple(
-                                            std::move(current_schedule), 0.0);
-                                    bool is_feasible = orcs::utils::evaluate(problem, neighbor);
+orcs::Reassignement::Reassignement(const orcs::CandidateLists* candidates, bool critical_only) :
+        candidates(candidates),
+        critical_only(critical_only) {
 
-                                    // Check if the current neighbor is better
-                                    if (is_feasible) {
-                                        if (std::get<double>(neighbor) < std::get<double>(best_neighbor)) {
-                                            best_neighbor = std::move(neighbor);
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
+}
 
-    // Return the best neighbor
-    return best_neighbor;
-}
-
-std::tuple<orcs::Schedule, double> orcs::Swap::first_improvement(const orcs::Problem& problem,
-        const std::tuple<orcs::Schedule, double>& entry, std::mt19937& generator) {
-
-    // Create a list of all possible movements
-    std::vector< std::tuple<int, int, int, int, int, int> > movements;
-    for (int l1 = 1; l1 <= problem.m; ++l1) {
-        if (std::get<Schedule>(entry)[l1].size() > 0) {
-            for (int l2 = l1 + 1; l2 <= problem.m; ++l2) {
-                if (std::get<Schedule>(entry)[l2].size() > 0) {
-                    for (int idx1 = 0; idx1 < std::get<Schedule>(entry)[l1].size(); ++idx1) {
-                        for (int idx2 = 0; idx2 < std::get<Schedule>(entry)[l2].size(); ++idx2) {
-                            for (int target1 = 0; target1 <= std::get<Schedule>(entry)[l2].size() - 1; ++target1) {
-                                for (int target2 = 0; target2 <= std::get<Schedule>(entry)[l1].size() - 1; ++target2) {
-                                    movements.emplace_back(l1, l2, idx1, idx2, target1, target2);
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
+std::string orcs::Reassignement::name() const {
+    return "Reassignment";
+}
 
-    // Shuffle the list of possible movements
-    std::shuffle(movements.begin(), movements.end(), generator);
+std::tuple<orcs::Schedule, double> orcs::Reassignement::best_improvement(const orcs::Problem&,
+        const std::tuple<orcs::Schedule, double>& entry, orcs::SearchContext& context) {
+    return best_move(entry, MoveType::REASSIGN, context, candidates, critical_only);
+}
 
-    // Keep the best neighbor
-    std::tuple<Schedule, double> best_neighbor = entry;
+std::tuple<orcs::Schedule, double> orcs::Reassignement::first_improvement(const orcs::Problem&,
+        const std::tuple<orcs::Schedule, double>& entry, orcs::SearchContext& context,
+        std::mt19937& generator) {
+    return first_move(entry, MoveType::REASSIGN, context, generator, candidates, critical_only);
+}
 
-    // Evaluate neighbors until find a first one that improves the objective function
-    for (const auto& movement : movements) {
+std::tuple<orcs::Schedule, double> orcs::Reassignement::shake(const orcs::Problem&,
+        const std::tuple<orcs::Schedule, double>& entry, bool feasible_only,
+        orcs::SearchContext& context, std::mt19937& generator) {
+    return shake_move(entry, MoveType::REASSIGN, feasible_only, context, generator);
+}
 
-        // Get the attributes of the movemnt
-        int l1, l2, idx1, idx2, target1, target2;
-        std::tie(l1, l2, idx1, idx2, target1, target2) = movement;
 
-        // Evalutate the movement
-        Schedule current_schedule = std::get<Schedule>(entry);
+orcs::Swap::Swap(const orcs::CandidateLists* candidates, bool critical_only) :
+        candidates(candidates),
+        critical_only(critical_only) {
 
-        Maneuver maneuver1 = current_schedule[l1][idx1];
-        current_schedule[l1].erase(current_schedule[l1].begin() + idx1);
+}
 
-        Maneuver maneuver2 = current_schedule[l2][idx2];
-        current_schedule[l2].erase(current_schedule[l2].begin() + idx2);
+std::string orcs::Swap::name() const {
+    return "Swap";
+}
 
-        current_schedule[l2].insert(current_schedule[l2].begin() + target1, maneuver1);
-        current_schedule[l1].insert(current_schedule[l1].begin() + target2, maneuver2);
+std::tuple<orcs::Schedule, double> orcs::Swap::best_improvement(const orcs::Problem&,
+        const std::tuple<orcs::Schedule, double>& entry, orcs::SearchContext& context) {
+    return best_move(entry, MoveType::SWAP, context, candidates, critical_only);
+}
 
-        std::tuple<Schedule, double> neighbor = std::make_tuple(std::move(current_schedule), 0.0);
-        bool is_feasible = orcs::utils::evaluate(problem, neighbor);
+std::tuple<orcs::Schedule, double> orcs::Swap::first_improvement(const orcs::Problem&,
+        const std::tuple<orcs::Schedule, double>& entry, orcs::SearchContext& context,
+        std::mt19937& generator) {
+    return first_move(entry, MoveType::SWAP, context, generator, candidates, critical_only);
+}
 
-        // Check if the current neighbor is better
-        if (is_feasible) {
-            if (std::get<double>(neighbor) < std::get<double>(best_neighbor)) {
-                best_neighbor = std::move(neighbor);
-                break;
-            }
-        }
-    }
+std::tuple<orcs::Schedule, double> orcs::Swap::shake(const orcs::Problem&,
+        const std::tuple<orcs::Schedule, double>& entry, bool feasible_only,
+        orcs::SearchContext& context, std::mt19937& generator) {
+    return shake_move(entry, MoveType::SWAP, feasible_only, context, generator);
+}
+
+
+orcs::PairSwap::PairSwap(bool critical_only) :
+        critical_only(critical_only) {
 
-    // Return the first improvement neighbor
-    return best_neighbor;
 }
 
-std::tuple<orcs::Schedule, double> orcs::Swap::shake(const orcs::Problem& problem,
-        const std::tuple<orcs::Schedule, double>& entry, bool feasible_only,
-        std::mt19937& generator) {
+std::string orcs::PairSwap::name() const {
+    return "Pair swap";
+}
 
-    // Create a list of all possible movements
-    std::vector< std::tuple<int, int, int, int, int, int> > movements;
-    for (int l1 = 1; l1 <= problem.m; ++l1) {
-        if (std::get<Schedule>(entry)[l1].size() > 0) {
-            for (int l2 = l1 + 1; l2 <= problem.m; ++l2) {
-                if (std::get<Schedule>(entry)[l2].size() > 0) {
-                    for (int idx1 = 0; idx1 < std::get<Schedule>(entry)[l1].size(); ++idx1) {
-                        for (int idx2 = 0; idx2 < std::get<Schedule>(entry)[l2].size(); ++idx2) {
-                            for (int target1 = 0; target1 <= std::get<Schedule>(entry)[l2].size() - 1; ++target1) {
-                                for (int target2 = 0; target2 <= std::get<Schedule>(entry)[l1].size() - 1; ++target2) {
-                                    movements.emplace_back(l1, l2, idx1, idx2, target1, target2);
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
+std::tuple<orcs::Schedule, double> orcs::PairSwap::best_improvement(const orcs::Problem&,
+        const std::tuple<orcs::Schedule, double>& entry, orcs::SearchContext& context) {
+    return best_move(entry, MoveType::PAIR_SWAP, context, nullptr, critical_only);
+}
 
-    // Shuffle the list of possible movements
-    std::shuffle(movements.begin(), movements.end(), generator);
+std::tuple<orcs::Schedule, double> orcs::PairSwap::first_improvement(const orcs::Problem&,
+        const std::tuple<orcs::Schedule, double>& entry, orcs::SearchContext& context,
+        std::mt19937& generator) {
+    return first_move(entry, MoveType::PAIR_SWAP, context, generator, nullptr, critical_only);
+}
 
-    // Keep the neighbor obtained by the shake movement
-    std::tuple<Schedule, double> shaked = entry;
+std::tuple<orcs::Schedule, double> orcs::PairSwap::shake(const orcs::Problem&,
+        const std::tuple<orcs::Schedule, double>& entry, bool feasible_only,
+        orcs::SearchContext& context, std::mt19937& generator) {
+    return shake_move(entry, MoveType::PAIR_SWAP, feasible_only, context, generator);
+}
 
-    // Evaluate neighbors until find a first one that improves the objective function
-    for (const auto& movement : movements) {
 
-        // Get the attributes of the movemnt
-        int l1, l2, idx1, idx2, target1, target2;
-        std::tie(l1, l2, idx1, idx2, target1, target2) = movement;
+std::string orcs::OrOpt::name() const {
+    return "Or-opt";
+}
 
-        // Evalutate the movement
-        Schedule current_schedule = std::get<Schedule>(entry);
+std::tuple<orcs::Schedule, double> orcs::OrOpt::best_improvement(const orcs::Problem&,
+        const std::tuple<orcs::Schedule, double>& entry, orcs::SearchContext& context) {
+    return best_move(entry, MoveType::OR_OPT, context);
+}
 
-        Maneuver maneuver1 = current_schedule[l1][idx1];
-        current_schedule[l1].erase(current_schedule[l1].begin() + idx1);
+std::tuple<orcs::Schedule, double> orcs::OrOpt::first_improvement(const orcs::Problem&,
+        const std::tuple<orcs::Schedule, double>& entry, orcs::SearchContext& context,
+        std::mt19937& generator) {
+    return first_move(entry, MoveType::OR_OPT, context, generator);
+}
 
-        Maneuver maneuver2 = current_schedule[l2][idx2];
-        current_schedule[l2].erase(current_schedule[l2].begin() + idx2);
+std::tuple<orcs::Schedule, double> orcs::OrOpt::shake(const orcs::Problem&,
+        const std::tuple<orcs::Schedule, double>& entry, bool feasible_only,
+        orcs::SearchContext& context, std::mt19937& generator) {
+    return shake_move(entry, MoveType::OR_OPT, feasible_only, context, generator);
+}
 
-        current_schedule[l2].insert(current_schedule[l2].begin() + target1, maneuver1);
-        current_schedule[l1].insert(current_schedule[l1].begin() + target2, maneuver2);
 
-        std::tuple<Schedule, double> neighbor = std::make_tuple(std::move(current_schedule), 0.0);
-        bool is_feasible = orcs::utils::evaluate(problem, neighbor);
+std::string orcs::TailExchange::name() const {
+    return "Tail exchange";
+}
 
-        // Check if the current neighbor is better
-        if (is_feasible || !feasible_only) {
-            shaked = std::move(neighbor);
-            break;
-        }
+std::tuple<orcs::Schedule, double> orcs::TailExchange::best_improvement(const orcs::Problem&,
+        const std::tuple<orcs::Schedule, double>& entry, orcs::SearchContext& context) {
+    return best_move(entry, MoveType::TAIL_EXCHANGE, context);
+}
 
-    }
+std::tuple<orcs::Schedule, double> orcs::TailExchange::first_improvement(const orcs::Problem&,
+        const std::tuple<orcs::Schedule, double>& entry, orcs::SearchContext& context,
+        std::mt19937& generator) {
+    return first_move(entry, MoveType::TAIL_EXCHANGE, context, generator);
+}
 
-    // Return the first improvement neighbor
-    return shaked;
+std::tuple<orcs::Schedule, double> orcs::TailExchange::shake(const orcs::Problem&,
+        const std::tuple<orcs::Schedule, double>& entry, bool feasible_only,
+        orcs::SearchContext& context, std::mt19937& generator) {
+    return shake_move(entry, MoveType::TAIL_EXCHANGE, feasible_only, context, generator);
 }
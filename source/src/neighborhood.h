@@ -2,13 +2,70 @@
 #define MANEUVERS_SCHEDULING_NEIGHBORHOOD_H
 
 #include <random>
+#include <string>
+
+#include <cxxtimer.hpp>
 
 #include "algorithm.h"
+#include "candidate_lists.h"
+#include "move.h"
 #include "problem.h"
+#include "search_context.h"
 
 
 namespace orcs {
 
+    /**
+     * Performance counters of a neighborhood, accumulated over its searches for
+     * improving neighbors (perturbations are not counted). A move is generated if
+     * it is visited by a search; it is rejected if it certainly leads to an
+     * infeasible schedule (see MoveFilter) or if its evaluation finds it infeasible;
+     * it is evaluated if its makespan is computed by the evaluator, even if the
+     * evaluation is aborted by a bound; and it is priced if its makespan is computed
+     * exactly in constant time (see SegmentData), in which case it is not evaluated.
+     */
+    class NeighborhoodStatistics {
+
+    public:
+
+        /**
+         * Start timing a search for an improving neighbor.
+         */
+        void start_search();
+
+        /**
+         * Stop timing a search for an improving neighbor.
+         *
+         * @param   improving
+         *          Whether the search has found an improving neighbor.
+         */
+        void stop_search(bool improving);
+
+        /**
+         * Add the counters of another object (e.g., of a worker thread).
+         */
+        void add(const NeighborhoodStatistics& other);
+
+        /**
+         * Store the counters in the optional output of an algorithm, under keys
+         * prefixed by the given name.
+         */
+        void report(const std::string& name, cxxproperties::Properties* opt_output) const;
+
+        long searches = 0;
+        long improving = 0;
+        long generated = 0;
+        long rejected = 0;
+        long evaluated = 0;
+        long priced = 0;
+        double time = 0.0;
+
+    private:
+
+        cxxtimer::Timer timer;
+
+    };
+
     /**
      * Base class that defines the interface implemented by all neighborhoods.
      */
@@ -16,6 +73,16 @@ namespace orcs {
 
     public:
 
+        /**
+         * Destructor.
+         */
+        virtual ~Neighborhood() = default;
+
+        /**
+         * Return the name of the neighborhood (used to report its statistics).
+         */
+        virtual std::string name() const = 0;
+
         /**
          * Return the best neighbor of the given entry.
          *
@@ -23,12 +90,14 @@ namespace orcs {
          *          Instance of the problem being optimized.
          * @param   entry
          *          The start solution to perform the local search.
+         * @param   context
+         *          The search context (owned by the calling thread).
          *
          * @return  A tuple of two elements, in which the first is the
          *          schedule and the second is the makespan.
          */
         virtual std::tuple<orcs::Schedule, double> best_improvement(const Problem& problem,
-                const std::tuple<Schedule, double>& entry) = 0;
+                const std::tuple<Schedule, double>& entry, SearchContext& context) = 0;
 
         /**
          * Return the first neighbor that improves the objective function.
@@ -37,6 +106,8 @@ namespace orcs {
          *          Instance of the problem being optimized.
          * @param   entry
          *          The start solution to perform the local search.
+         * @param   context
+         *          The search context (owned by the calling thread).
          * @param   generator
          *          The random number generator.
          *
@@ -44,7 +115,7 @@ namespace orcs {
          *          schedule and the second is the makespan.
          */
         virtual std::tuple<orcs::Schedule, double> first_improvement(const Problem& problem,
-                const std::tuple<Schedule, double>& entry,
+                const std::tuple<Schedule, double>& entry, SearchContext& context,
                 std::mt19937& generator) = 0;
 
         /**
@@ -57,6 +128,8 @@ namespace orcs {
          * @param   feasible_only
          *          If false, only feasible solutions can be returned. If false,
          *          infeasible solutions can be returned.
+         * @param   context
+         *          The search context (owned by the calling thread).
          * @param   generator
          *          The random number generator.
          *
@@ -65,64 +138,300 @@ namespace orcs {
          */
         virtual std::tuple<orcs::Schedule, double> shake(const Problem& problem,
                 const std::tuple<Schedule, double>& entry, bool feasible_only,
-                std::mt19937& generator) = 0;
+                SearchContext& context, std::mt19937& generator) = 0;
+
+        // Performance counters (the searches are timed by the caller, see LocalSearch)
+        NeighborhoodStatistics statistics;
+
+    protected:
+
+        /**
+         * Return the best neighbor of the given entry among all moves of a type. The
+         * moves are scanned in the order of their indexes (see MoveSpace), split among
+         * the workers of the thread pool of the context (if any). The best neighbor
+         * is the one with the lowest makespan and, among those, the one with the
+         * lowest index, so the result does not depend on the number of threads.
+         *
+         * @param   entry
+         *          The start solution to perform the local search.
+         * @param   type
+         *          The type of the moves.
+         * @param   context
+         *          The search context (owned by the calling thread).
+         * @param   candidates
+         *          The candidate lists of the granular moves (nullptr, if all
+         *          moves must be considered).
+         * @param   critical_only
+         *          If true, only moves of switches in the critical path of the
+         *          entry are considered.
+         *
+         * @return  A tuple of two elements, in which the first is the
+         *          schedule and the second is the makespan.
+         */
+        std::tuple<orcs::Schedule, double> best_move(const std::tuple<Schedule, double>& entry,
+                MoveType type, SearchContext& context, const CandidateLists* candidates = nullptr,
+                bool critical_only = false);
+
+        /**
+         * Return the first neighbor of the given entry, among all moves of a type
+         * visited in random order, that improves the objective function.
+         *
+         * @param   entry
+         *          The start solution to perform the local search.
+         * @param   type
+         *          The type of the moves.
+         * @param   context
+         *          The search context (owned by the calling thread).
+         * @param   generator
+         *          The random number generator.
+         * @param   candidates
+         *          The candidate lists of the granular moves (nullptr, if all
+         *          moves must be considered).
+         * @param   critical_only
+         *          If true, only moves of switches in the critical path of the
+         *          entry are considered.
+         *
+         * @return  A tuple of two elements, in which the first is the
+         *          schedule and the second is the makespan.
+         */
+        std::tuple<orcs::Schedule, double> first_move(const std::tuple<Schedule, double>& entry,
+                MoveType type, SearchContext& context, std::mt19937& generator,
+                const CandidateLists* candidates = nullptr, bool critical_only = false);
 
+        /**
+         * Return the neighbor of the given entry obtained by the first move of a type,
+         * among all moves of the type visited in random order, that leads to a
+         * feasible neighbor (or by the first move, if infeasible neighbors are
+         * allowed).
+         *
+         * @param   entry
+         *          The start solution to perform the local search.
+         * @param   type
+         *          The type of the moves.
+         * @param   feasible_only
+         *          If true, only feasible solutions can be returned. If false,
+         *          infeasible solutions can be returned.
+         * @param   context
+         *          The search context (owned by the calling thread).
+         * @param   generator
+         *          The random number generator.
+         *
+         * @return  A tuple of two elements, in which the first is the
+         *          schedule and the second is the makespan.
+         */
+        std::tuple<orcs::Schedule, double> shake_move(const std::tuple<Schedule, double>& entry,
+                MoveType type, bool feasible_only, SearchContext& context, std::mt19937& generator);
 
     };
 
 
     /**
-     * Shift neighborhood.
+     * Shift neighborhood. It may be restricted to moves of switches in the critical
+     * path (see DeltaEvaluator::find_critical_path) when searching for improvements:
+     * other moves keep the critical path, so they cannot reduce the makespan unless
+     * a switch is inserted into it and the travel times violate the triangle
+     * inequality.
      */
     class Shift : public Neighborhood {
 
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param   critical_only
+         *          If true, only moves of critical switches are considered when
+         *          searching for improvements.
+         */
+        explicit Shift(bool critical_only = false);
+
+    private:
+
+        std::string name() const override;
+
         std::tuple<orcs::Schedule, double> best_improvement(const Problem& problem,
-                const std::tuple<Schedule, double>& entry) override;
+                const std::tuple<Schedule, double>& entry, SearchContext& context) override;
 
         std::tuple<orcs::Schedule, double> first_improvement(const Problem& problem,
-                const std::tuple<Schedule, double>& entry,
+                const std::tuple<Schedule, double>& entry, SearchContext& context,
                 std::mt19937& generator) override;
 
         std::tuple<orcs::Schedule, double> shake(const Problem& problem,
                 const std::tuple<Schedule, double>& entry, bool feasible_only,
-                std::mt19937& generator) override;
+                SearchContext& context, std::mt19937& generator) override;
+
+        bool critical_only;
 
     };
 
     /**
-     * Reassignment neighborhood.
+     * Reassignment neighborhood. If candidate lists are given, the neighborhood is
+     * granular (see MoveSpace) when searching for improvements. Perturbations
+     * consider all moves.
      */
     class Reassignement : public Neighborhood {
 
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param   candidates
+         *          The candidate lists of the granular moves (nullptr, if all
+         *          moves must be considered).
+         * @param   critical_only
+         *          If true, only moves of critical switches are considered when
+         *          searching for improvements (see Shift).
+         */
+        explicit Reassignement(const CandidateLists* candidates = nullptr, bool critical_only = false);
+
+    private:
+
+        std::string name() const override;
+
         std::tuple<orcs::Schedule, double> best_improvement(const Problem& problem,
-                const std::tuple<Schedule, double>& entry) override;
+                const std::tuple<Schedule, double>& entry, SearchContext& context) override;
 
         std::tuple<orcs::Schedule, double> first_improvement(const Problem& problem,
-                const std::tuple<Schedule, double>& entry,
+                const std::tuple<Schedule, double>& entry, SearchContext& context,
                 std::mt19937& generator) override;
 
         std::tuple<orcs::Schedule, double> shake(const Problem& problem,
                 const std::tuple<Schedule, double>& entry, bool feasible_only,
-                std::mt19937& generator) override;
+                SearchContext& context, std::mt19937& generator) override;
+
+        const CandidateLists* candidates;
+        bool critical_only;
 
     };
 
     /**
-     * Swap neighborhood.
+     * Swap neighborhood. If candidate lists are given, the neighborhood is granular
+     * (see MoveSpace) when searching for improvements. Perturbations consider all
+     * moves. Moves are priced in constant time from segment data (see SegmentData)
+     * and skipped if their lower bound reaches the best makespan found.
      */
     class Swap : public Neighborhood {
 
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param   candidates
+         *          The candidate lists of the granular moves (nullptr, if all
+         *          moves must be considered).
+         * @param   critical_only
+         *          If true, only moves of critical switches are considered when
+         *          searching for improvements (see Shift).
+         */
+        explicit Swap(const CandidateLists* candidates = nullptr, bool critical_only = false);
+
+    private:
+
+        std::string name() const override;
+
         std::tuple<orcs::Schedule, double> best_improvement(const Problem& problem,
-                const std::tuple<Schedule, double>& entry) override;
+                const std::tuple<Schedule, double>& entry, SearchContext& context) override;
 
         std::tuple<orcs::Schedule, double> first_improvement(const Problem& problem,
-                const std::tuple<Schedule, double>& entry,
+                const std::tuple<Schedule, double>& entry, SearchContext& context,
                 std::mt19937& generator) override;
 
         std::tuple<orcs::Schedule, double> shake(const Problem& problem,
                 const std::tuple<Schedule, double>& entry, bool feasible_only,
+                SearchContext& context, std::mt19937& generator) override;
+
+        const CandidateLists* candidates;
+        bool critical_only;
+
+    };
+
+    /**
+     * Pair swap neighborhood: exchanges two switches of different teams in place,
+     * i.e., each one takes the position of the other one. It is the subset of the
+     * swap neighborhood (which tries every position for both switches) with a
+     * quadratic number of moves, so it is meant to be examined before it.
+     */
+    class PairSwap : public Neighborhood {
+
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param   critical_only
+         *          If true, only moves of critical switches are considered when
+         *          searching for improvements (see Shift).
+         */
+        explicit PairSwap(bool critical_only = false);
+
+    private:
+
+        std::string name() const override;
+
+        std::tuple<orcs::Schedule, double> best_improvement(const Problem& problem,
+                const std::tuple<Schedule, double>& entry, SearchContext& context) override;
+
+        std::tuple<orcs::Schedule, double> first_improvement(const Problem& problem,
+                const std::tuple<Schedule, double>& entry, SearchContext& context,
+                std::mt19937& generator) override;
+
+        std::tuple<orcs::Schedule, double> shake(const Problem& problem,
+                const std::tuple<Schedule, double>& entry, bool feasible_only,
+                SearchContext& context, std::mt19937& generator) override;
+
+        bool critical_only;
+
+    };
+
+    /**
+     * Or-opt neighborhood: moves segments of 2 to 3 consecutive switches to another
+     * position of the same team or of another team (see MoveSpace). Moves are
+     * priced in constant time from segment data (see SegmentData), which is exact
+     * if the teams changed have no precedence relation with other teams and the
+     * segment has no precedence relation at all, and a lower bound otherwise.
+     */
+    class OrOpt : public Neighborhood {
+
+        std::string name() const override;
+
+        std::tuple<orcs::Schedule, double> best_improvement(const Problem& problem,
+                const std::tuple<Schedule, double>& entry, SearchContext& context) override;
+
+        std::tuple<orcs::Schedule, double> first_improvement(const Problem& problem,
+                const std::tuple<Schedule, double>& entry, SearchContext& context,
                 std::mt19937& generator) override;
 
+        std::tuple<orcs::Schedule, double> shake(const Problem& problem,
+                const std::tuple<Schedule, double>& entry, bool feasible_only,
+                SearchContext& context, std::mt19937& generator) override;
+
+    };
+
+    /**
+     * Tail exchange neighborhood (2-opt*): exchanges the tails of the sequences of two
+     * teams at any pair of cut points, which moves many switches between teams in a
+     * single move. Moves are priced in constant time from segment data (see
+     * SegmentData), which is exact if the teams have no precedence relation with
+     * other teams and the tails have no precedence relation with the rest of their
+     * teams, and a lower bound otherwise.
+     */
+    class TailExchange : public Neighborhood {
+
+        std::string name() const override;
+
+        std::tuple<orcs::Schedule, double> best_improvement(const Problem& problem,
+                const std::tuple<Schedule, double>& entry, SearchContext& context) override;
+
+        std::tuple<orcs::Schedule, double> first_improvement(const Problem& problem,
+                const std::tuple<Schedule, double>& entry, SearchContext& context,
+                std::mt19937& generator) override;
+
+        std::tuple<orcs::Schedule, double> shake(const Problem& problem,
+                const std::tuple<Schedule, double>& entry, bool feasible_only,
+                SearchContext& context, std::mt19937& generator) override;
+
     };
 
 }
@@ -1,6 +1,8 @@
 #include "problem.h"
+#include <algorithm>
 #include <cmath>
 #include <fstream>
+#include <limits>
 
 
 orcs::Problem::Problem(const std::string& filename) {
@@ -19,13 +21,13 @@ orcs::Problem::Problem(const std::string& filename) {
     action = std::vector<Action>(n + 1, Action::UNKNOWN);
     stage = std::vector<int>(n + 1, 0);
 
-    precedence_matrix = std::vector< std::vector<bool> >(n + 1, std::vector<bool>(n + 1, false));
+    precedence_matrix = BitMatrix(n + 1);
+    precedence_matrix_transposed = BitMatrix(n + 1);
     predecessors = std::vector< std::set<int> >(n + 1, std::set<int>());
     successors = std::vector< std::set<int> >(n + 1, std::set<int>());
 
     p = std::vector<double>(n + 1, 0.0);
-    c = std::vector< std::vector< std::vector<double> > >(
-            n + 1, std::vector< std::vector<double> >(n + 1, std::vector<double>(m + 1, 0.0)));
+    travel_times = std::vector<double>(static_cast<std::size_t>(m + 1) * (n + 1) * (n + 1), 0.0);
 
     // Read switches data
     for (std::size_t i = 1; i <= n; ++i) {
@@ -82,53 +84,99 @@ orcs::Problem::Problem(const std::string& filename) {
         }
     }
 
-    // Read the travel time matrices
+    // Contiguous (CSR) copies of the precedence graph, used by the hot loops
+    predecessors_csr = Adjacency(predecessors);
+    successors_csr = Adjacency(successors);
+
+    // Read the travel time matrices (they are stored in the same order they are read)
+    std::size_t offset = static_cast<std::size_t>(n + 1) * (n + 1);
     for (int l = 1; l <= m; ++l) {
         for (int i = 0; i <= n; ++i) {
             for (int j = 0; j <= n; ++j) {
                 file >> token;
-                c[i][j][l] = std::stod(token);
+                travel_times[offset++] = std::stod(token);
             }
         }
     }
 
-    // Compute the full precedence matrix
-    std::vector<bool> processed(n + 1, false);
-    std::set<int> pending;
-    for (std::size_t j = 1; j <= n; ++j) {
+    // Check whether all times are integer values. If so (and a schedule that performs
+    // all maneuvers and travels one after the other fits in 32 bits), the times are
+    // also stored as integers, which makes the evaluation exact. The real times are
+    // kept, so the time type is chosen once by the evaluators instead of on each read.
+    double total_time = 0.0;
+    integer_times = true;
+    for (int i = 1; i <= n; ++i) {
+        integer_times = integer_times && (p[i] >= 0.0 && std::floor(p[i]) == p[i]);
+        total_time += p[i];
+    }
 
-        // Clear the data structures used
-        std::fill(processed.begin(), processed.end(), false);
-        pending.clear();
+    double max_travel_time = 0.0;
+    for (auto value : travel_times) {
+        integer_times = integer_times && (value >= 0.0 && std::floor(value) == value);
+        max_travel_time = std::max(max_travel_time, value);
+    }
 
-        // Initialize the data structures
-        for (auto i : predecessors[j]) {
-            pending.insert(i);
+    total_time += max_travel_time * (n + 1);
+    integer_times = integer_times && (total_time < std::numeric_limits<std::int32_t>::max());
+
+    if (integer_times) {
+        p_integer = std::vector<std::int32_t>(p.begin(), p.end());
+        travel_times_integer = std::vector<std::int32_t>(travel_times.begin(), travel_times.end());
+    }
+
+    // Compute the full precedence matrix (transitive closure of the precedence graph).
+    // Switches are visited in reverse topological order, so the row of a switch is
+    // the union of the rows of its direct successors (and the successors themselves).
+    std::vector<int> pendings(n + 1, 0);
+    std::vector<int> order;
+    order.reserve(n + 1);
+    for (int i = 0; i <= n; ++i) {
+        pendings[i] = predecessors_csr[i].size();
+        if (pendings[i] == 0) {
+            order.push_back(i);
         }
+    }
 
-        // Compute the precedence graph of j
-        while (!pending.empty()) {
+    for (std::size_t head = 0; head < order.size(); ++head) {
+        for (auto j : successors_csr[order[head]]) {
+            if (--pendings[j] == 0) {
+                order.push_back(j);
+            }
+        }
+    }
 
-            // Get an element from the pending set
-            auto iter = pending.begin();
-            int i = *iter;
-            pending.erase(iter);
+    if (static_cast<int>(order.size()) == n + 1) {
+        for (auto iter = order.rbegin(); iter != order.rend(); ++iter) {
+            for (auto j : successors_csr[*iter]) {
+                precedence_matrix.set(*iter, j);
+                precedence_matrix.merge(*iter, j);
+            }
+        }
 
-            // Update the precedence matrix
-            precedence_matrix[i][j] = true;
+    } else {
 
-            // Check i as processed
-            processed[i] = true;
+        // The precedence graph has cycles: Warshall's algorithm (row-wise)
+        for (int i = 0; i <= n; ++i) {
+            for (auto j : successors_csr[i]) {
+                precedence_matrix.set(i, j);
+            }
+        }
 
-            // Add the predecessors of i into the pending set
-            for (auto k : predecessors[i]) {
-                if (!processed[k]) {
-                    pending.insert(k);
+        for (int k = 0; k <= n; ++k) {
+            for (int i = 0; i <= n; ++i) {
+                if (precedence_matrix.test(i, k)) {
+                    precedence_matrix.merge(i, k);
                 }
             }
         }
     }
 
+    for (int i = 0; i <= n; ++i) {
+        precedence_matrix.for_each(i, [this, i](int j) {
+            precedence_matrix_transposed.set(j, i);
+        });
+    }
+
     // Close the file
     file.close();
 }
@@ -240,7 +288,7 @@ bool orcs::Problem::is_feasible(const Schedule &schedule, std::string *msg) cons
         if (!schedule[l].empty()) {
 
             // Origin to switch
-            if (std::get<ATTR_MOMENT>(schedule[l][0]) + 1e-5 < c[0][std::get<ATTR_SWITCH>(schedule[l][0])][l]) {
+            if (std::get<ATTR_MOMENT>(schedule[l][0]) + 1e-5 < c(0, std::get<ATTR_SWITCH>(schedule[l][0]), l)) {
                 if (msg != nullptr) {
                     *msg = "Moments not consistent to travel times.";
                 }
@@ -252,7 +300,7 @@ bool orcs::Problem::is_feasible(const Schedule &schedule, std::string *msg) cons
                 for (int i = 1; i < schedule[l].size(); ++i) {
                     if (std::get<ATTR_MOMENT>(schedule[l][i]) + 1e-5 <
                             std::get<ATTR_MOMENT>(schedule[l][i-1]) + p[std::get<ATTR_SWITCH>(schedule[l][i])] +
-                            c[std::get<ATTR_SWITCH>(schedule[l][i-1])][std::get<ATTR_SWITCH>(schedule[l][i])][l]) {
+                            c(std::get<ATTR_SWITCH>(schedule[l][i-1]), std::get<ATTR_SWITCH>(schedule[l][i]), l)) {
 
                         if (msg != nullptr) {
                             *msg = "Moments not consistent to travel times.";
@@ -265,10 +313,45 @@ bool orcs::Problem::is_feasible(const Schedule &schedule, std::string *msg) cons
     }
 
     // All constraints are met
-    *msg = "Feasible solution.";
+    if (msg != nullptr) {
+        *msg = "Feasible solution.";
+    }
     return true;
 }
 
+orcs::BitMatrix::BitMatrix(int size) :
+        n_words((size + 63) / 64),
+        data(static_cast<std::size_t>(size) * ((size + 63) / 64), 0ULL) {
+
+}
+
+void orcs::BitMatrix::merge(int i, int k) {
+    std::uint64_t* target = row(i);
+    const std::uint64_t* source = row(k);
+    for (int w = 0; w < n_words; ++w) {
+        target[w] |= source[w];
+    }
+}
+
+bool orcs::BitMatrix::intersects(int i, int k) const {
+    const std::uint64_t* first = row(i);
+    const std::uint64_t* second = row(k);
+    std::uint64_t common = 0;
+    for (int w = 0; w < n_words; ++w) {
+        common |= first[w] & second[w];
+    }
+    return common != 0;
+}
+
+orcs::Adjacency::Adjacency(const std::vector< std::set<int> >& lists) {
+    offset.reserve(lists.size() + 1);
+    offset.push_back(0);
+    for (const auto& list : lists) {
+        index.insert(index.end(), list.begin(), list.end());
+        offset.push_back(static_cast<int>(index.size()));
+    }
+}
+
 std::ostream& operator<<(std::ostream& os, orcs::Schedule schedule) {
     os << "REMOTE : < ";
     for (const auto& maneuver : schedule[0]) {
@@ -2,6 +2,7 @@
 #define MANEUVERS_SCHEDULING_PROBLEM_H
 
 #include <cstddef>
+#include <cstdint>
 #include <tuple>
 #include <vector>
 #include <set>
@@ -63,6 +64,147 @@ namespace orcs {
         return std::vector< std::vector<Maneuver> >(m+1, std::vector<Maneuver>());
     }
 
+    /**
+     * Adjacency lists of a graph stored in the compressed sparse row (CSR)
+     * format: the neighbors of vertex i are stored contiguously in positions
+     * offset[i] to offset[i+1]-1 of the index array.
+     */
+    class Adjacency {
+
+    public:
+
+        /**
+         * A range of contiguous vertex IDs (the neighbors of a vertex). It can
+         * be used in range-based for loops.
+         */
+        class Range {
+
+        public:
+
+            Range(const int* first, const int* last) : first(first), last(last) { }
+
+            const int* begin() const { return first; }
+
+            const int* end() const { return last; }
+
+            std::size_t size() const { return static_cast<std::size_t>(last - first); }
+
+            bool empty() const { return first == last; }
+
+        private:
+
+            const int* first;
+            const int* last;
+
+        };
+
+        std::vector<int> offset;
+        std::vector<int> index;
+
+        /**
+         * Constructor. Creates an empty graph.
+         */
+        Adjacency() = default;
+
+        /**
+         * Constructor.
+         *
+         * @param   lists
+         *          The adjacency lists of the graph, in which the i-th set
+         *          contains the neighbors of vertex i.
+         */
+        explicit Adjacency(const std::vector< std::set<int> >& lists);
+
+        /**
+         * Return the neighbors of a vertex.
+         *
+         * @param   i
+         *          The vertex.
+         * @return  The range of neighbors of vertex i.
+         */
+        Range operator[](int i) const {
+            return Range(index.data() + offset[i], index.data() + offset[i + 1]);
+        }
+
+    };
+
+    /**
+     * A square matrix of bits, in which each row is packed into 64-bit words.
+     * Row-wide operations (union and intersection of rows) are performed one
+     * word at a time.
+     */
+    class BitMatrix {
+
+    public:
+
+        /**
+         * Constructor. Creates an empty matrix.
+         */
+        BitMatrix() = default;
+
+        /**
+         * Constructor. Creates a matrix with all bits unset.
+         *
+         * @param   size
+         *          The number of rows (and columns) of the matrix.
+         */
+        explicit BitMatrix(int size);
+
+        /**
+         * Return the number of 64-bit words used by each row.
+         */
+        inline int words() const {
+            return n_words;
+        }
+
+        /**
+         * Return a pointer to the first word of row i.
+         */
+        inline const std::uint64_t* row(int i) const {
+            return data.data() + static_cast<std::size_t>(i) * n_words;
+        }
+
+        inline std::uint64_t* row(int i) {
+            return data.data() + static_cast<std::size_t>(i) * n_words;
+        }
+
+        /**
+         * Check whether bit (i, j) is set.
+         */
+        inline bool test(int i, int j) const {
+            return (row(i)[j >> 6] >> (j & 63)) & 1ULL;
+        }
+
+        /**
+         * Set bit (i, j).
+         */
+        inline void set(int i, int j) {
+            row(i)[j >> 6] |= (1ULL << (j & 63));
+        }
+
+        /**
+         * Merge row k into row i (i.e., row i becomes the union of both rows).
+         */
+        void merge(int i, int k);
+
+        /**
+         * Check whether rows i and k have a bit set in common.
+         */
+        bool intersects(int i, int k) const;
+
+        /**
+         * Call function f for each bit set in row i, in increasing order of column.
+         */
+        template <class TFunction>
+        void for_each(int i, TFunction f) const;
+
+    private:
+
+        int n_words = 0;
+        std::vector<std::uint64_t> data;
+
+    };
+
     /**
      * This class keeps the data of the maneuvers scheduling problem
      * in the restoration of electric power distribution networks.
@@ -78,11 +220,17 @@ namespace orcs {
         std::vector<Technology> technology;
         std::vector<Action> action;
         std::vector<int> stage;
+        bool integer_times;
         std::vector<double> p;
-        std::vector< std::vector< std::vector<double> > > c;
-        std::vector< std::vector<bool> > precedence_matrix;
+        std::vector<std::int32_t> p_integer;
+        std::vector<double> travel_times;
+        std::vector<std::int32_t> travel_times_integer;
+        BitMatrix precedence_matrix;
+        BitMatrix precedence_matrix_transposed;
         std::vector< std::set<int> > predecessors;
         std::vector< std::set<int> > successors;
+        Adjacency predecessors_csr;
+        Adjacency successors_csr;
 
         /**
          * Constructor.
@@ -92,6 +240,70 @@ namespace orcs {
          */
         Problem(const std::string& filename);
 
+        /**
+         * Check whether switch i is a (direct or indirect) predecessor of
+         * switch j, i.e., whether j cannot start before i is done.
+         *
+         * @param   i
+         *          A switch.
+         * @param   j
+         *          A switch.
+         * @return  True if i precedes j, false otherwise.
+         */
+        inline bool precedes(int i, int j) const {
+            return precedence_matrix.test(i, j);
+        }
+
+        /**
+         * Return the travel time of team l from switch i to switch j. The
+         * travel times are stored in a single contiguous array, in which the
+         * matrix of each team is stored in row-major order (i.e., indexed by
+         * [l][i][j]).
+         *
+         * @param   i
+         *          The origin switch (0 is the origin of the teams).
+         * @param   j
+         *          The destination switch.
+         * @param   l
+         *          The maintenance team.
+         * @return  The travel time.
+         */
+        inline double c(int i, int j, int l) const {
+            return travel_times[travel_index(i, j, l)];
+        }
+
+        /**
+         * Return the maneuver time of switch j as a value of type T. Type
+         * std::int32_t is only available for instances with integer times
+         * (see integer_times), in which case the times are exact.
+         *
+         * @tparam  T
+         *          The time type (double or std::int32_t).
+         * @param   j
+         *          The switch.
+         * @return  The maneuver time.
+         */
+        template <class T>
+        inline T maneuver_time(int j) const;
+
+        /**
+         * Return the travel time of team l from switch i to switch j as a value
+         * of type T. Type std::int32_t is only available for instances with
+         * integer times (see integer_times), in which case the times are exact.
+         *
+         * @tparam  T
+         *          The time type (double or std::int32_t).
+         * @param   i
+         *          The origin switch (0 is the origin of the teams).
+         * @param   j
+         *          The destination switch.
+         * @param   l
+         *          The maintenance team.
+         * @return  The travel time.
+         */
+        template <class T>
+        inline T travel_time(int i, int j, int l) const;
+
         /**
          * Evaluate a schedule (compute the makespan) for this
          * problem.
@@ -117,6 +329,12 @@ namespace orcs {
          */
         bool is_feasible(const Schedule &schedule, std::string *msg = nullptr) const;
 
+    private:
+
+        inline std::size_t travel_index(int i, int j, int l) const {
+            return (static_cast<std::size_t>(l) * (n + 1) + i) * (n + 1) + j;
+        }
+
     };
 
 }
@@ -135,4 +353,41 @@ namespace orcs {
 std::ostream& operator<<(std::ostream& os, orcs::Schedule schedule);
 
 
+/*
+ * Function definition.
+ */
+
+template <>
+inline double orcs::Problem::maneuver_time<double>(int j) const {
+    return p[j];
+}
+
+template <>
+inline std::int32_t orcs::Problem::maneuver_time<std::int32_t>(int j) const {
+    return p_integer[j];
+}
+
+template <>
+inline double orcs::Problem::travel_time<double>(int i, int j, int l) const {
+    return travel_times[travel_index(i, j, l)];
+}
+
+template <>
+inline std::int32_t orcs::Problem::travel_time<std::int32_t>(int i, int j, int l) const {
+    return travel_times_integer[travel_index(i, j, l)];
+}
+
+template <class TFunction>
+void orcs::BitMatrix::for_each(int i, TFunction f) const {
+    const std::uint64_t* bits = row(i);
+    for (int w = 0; w < n_words; ++w) {
+        std::uint64_t word = bits[w];
+        while (word != 0) {
+            f((w << 6) + __builtin_ctzll(word));
+            word &= word - 1;
+        }
+    }
+}
+
+
 #endif
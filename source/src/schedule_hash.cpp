@@ -0,0 +1,31 @@
+#include "schedule_hash.h"
+
+#include <random>
+
+
+orcs::ScheduleHash::ScheduleHash(const Problem& problem) :
+        n(problem.n),
+        m(problem.m),
+        team_keys((problem.n + 1) * (problem.m + 1)),
+        position_keys((problem.n + 1) * problem.n) {
+
+    std::mt19937_64 generator(0x5ced1e5ULL);
+    for (auto& key : team_keys) {
+        key = generator();
+    }
+
+    for (auto& key : position_keys) {
+        key = generator();
+    }
+}
+
+std::uint64_t orcs::ScheduleHash::hash(const Schedule& schedule) const {
+    std::uint64_t h = 0;
+    for (int l = 0; l < static_cast<int>(schedule.size()); ++l) {
+        for (int idx = 0; idx < static_cast<int>(schedule[l].size()); ++idx) {
+            h ^= key(std::get<ATTR_SWITCH>(schedule[l][idx]), l, idx);
+        }
+    }
+
+    return h;
+}
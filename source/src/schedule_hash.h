@@ -0,0 +1,55 @@
+#ifndef MANEUVERS_SCHEDULING_SCHEDULE_HASH_H
+#define MANEUVERS_SCHEDULING_SCHEDULE_HASH_H
+
+#include <cstdint>
+#include <vector>
+
+#include "problem.h"
+
+
+namespace orcs {
+
+    /**
+     * Zobrist hashing of the sequences of the teams of a schedule (the moments are
+     * ignored). Each triple (switch, team, position) has a random key, and the hash
+     * of a schedule is the exclusive or of the keys of its switches. Since a switch
+     * is scheduled once, the key of a triple is the exclusive or of a key of the
+     * pair (switch, team) and a key of the pair (switch, position), so the tables
+     * have O(n(n + m)) keys.
+     */
+    class ScheduleHash {
+
+    public:
+
+        /**
+         * Constructor. The keys are drawn from a fixed seed, so the hashes do not
+         * depend on the random number generators of the algorithms.
+         *
+         * @param   problem
+         *          Instance of the problem.
+         */
+        explicit ScheduleHash(const Problem& problem);
+
+        /**
+         * Return the hash of a schedule.
+         */
+        std::uint64_t hash(const Schedule& schedule) const;
+
+    private:
+
+        // Key of a switch scheduled in the given team and position
+        inline std::uint64_t key(int j, int l, int idx) const {
+            return team_keys[j * (m + 1) + l] ^ position_keys[j * n + idx];
+        }
+
+        int n;
+        int m;
+        std::vector<std::uint64_t> team_keys;
+        std::vector<std::uint64_t> position_keys;
+
+    };
+
+}
+
+
+#endif
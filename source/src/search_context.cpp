@@ -0,0 +1,27 @@
+#include "search_context.h"
+
+#include "move.h"
+
+
+orcs::SearchContext::SearchContext(const Problem& problem) :
+        problem(&problem),
+        evaluation(problem),
+        delta(problem),
+        dont_look(problem.n, MOVE_TYPES),
+        pool(nullptr),
+        filter(problem),
+        segments(problem),
+        deadline(nullptr) {
+
+}
+
+void orcs::SearchContext::set_thread_pool(ThreadPool* pool) {
+    this->pool = pool;
+    workers.clear();
+    if (pool != nullptr) {
+        workers.resize(pool->size());
+        for (int worker = 1; worker < pool->size(); ++worker) {
+            workers[worker].reset(new SearchContext(*problem));
+        }
+    }
+}
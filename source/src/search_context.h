@@ -0,0 +1,93 @@
+#ifndef MANEUVERS_SCHEDULING_SEARCH_CONTEXT_H
+#define MANEUVERS_SCHEDULING_SEARCH_CONTEXT_H
+
+#include <memory>
+#include <vector>
+
+#include "deadline.h"
+#include "dont_look_bits.h"
+#include "evaluator.h"
+#include "flat_schedule.h"
+#include "move_filter.h"
+#include "problem.h"
+#include "segment_data.h"
+#include "thread_pool.h"
+
+
+namespace orcs {
+
+    /**
+     * State of a local search trajectory: the incremental evaluation engine
+     * (DeltaEvaluator), the working schedule of the neighborhoods, the move filter
+     * (MoveFilter), the pricing of moves (SegmentData), the don't-look bits, the
+     * thread pool used to scan neighborhoods and the deadline, besides a workspace
+     * of the full evaluation (EvaluationContext). All of them are allocated once per
+     * trajectory. A context must not be shared among threads, i.e., each thread
+     * must own its context. The workers of its thread pool own the contexts in
+     * SearchContext::workers.
+     */
+    class SearchContext {
+
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param   problem
+         *          The instance of the problem the schedules belong to.
+         */
+        explicit SearchContext(const Problem& problem);
+
+        /**
+         * Set the thread pool used to scan neighborhoods in parallel and create a
+         * context for each of its workers (but the first one, which is the thread
+         * that owns this context).
+         *
+         * @param   pool
+         *          The thread pool (nullptr, if neighborhoods must be scanned by
+         *          the owner thread only).
+         */
+        void set_thread_pool(ThreadPool* pool);
+
+        /**
+         * Check whether the deadline of the context (if any) has expired.
+         */
+        inline bool expired() const {
+            return deadline != nullptr && deadline->expired();
+        }
+
+        // The instance of the problem
+        const Problem* problem;
+
+        // Workspace of the full evaluation
+        EvaluationContext evaluation;
+
+        // Incremental evaluation engine
+        DeltaEvaluator delta;
+
+        // Working schedule of the neighborhoods (moves are applied to and undone on it)
+        FlatSchedule working;
+
+        // Switches whose moves are examined by the local search
+        DontLookBits dont_look;
+
+        // Thread pool and the contexts of its workers (indexed by worker)
+        ThreadPool* pool;
+        std::vector< std::unique_ptr<SearchContext> > workers;
+
+        // Precedence-based move rejection
+        MoveFilter filter;
+
+        // Constant-time pricing of moves
+        SegmentData segments;
+
+        // Deadline of the optimization process (nullptr, if none), polled by the
+        // local search and by the neighborhoods
+        const Deadline* deadline;
+
+    };
+
+}
+
+
+#endif
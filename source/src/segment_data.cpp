@@ -0,0 +1,247 @@
+#include "segment_data.h"
+
+#include <algorithm>
+
+#include "utils.h"
+
+
+orcs::SegmentData::SegmentData(const Problem& problem) :
+        problem(&problem),
+        base(nullptr),
+        feasible(false),
+        isolated(problem.n + 1, 0),
+        local(problem.m + 1, 0),
+        completion(problem.m + 1, 0.0),
+        latest(problem.m + 1, 0),
+        team(problem.n + 1, 0),
+        location(problem.n + 1, 0) {
+
+    for (int j = 1; j <= problem.n; ++j) {
+        isolated[j] = (problem.predecessors_csr[j].empty() && problem.successors_csr[j].empty());
+    }
+}
+
+void orcs::SegmentData::load(const FlatSchedule& base, bool feasible) {
+
+    this->base = &base;
+    this->feasible = feasible;
+
+    const int m = problem->m;
+    const int size = static_cast<int>(base.switches.size());
+    related.assign(size + 1, 0);
+    split.assign(size + 1, 1);
+    duration.assign((m + 1) * size, 0.0);
+
+    for (int l = 0; l <= m; ++l) {
+        for (int g = base.offset[l]; g < base.offset[l + 1]; ++g) {
+            int j = base.switches[g];
+            team[j] = l;
+            location[j] = g;
+            related[g + 1] = related[g] + (isolated[j] ? 0 : 1);
+        }
+    }
+
+    for (int l = 0; l <= m; ++l) {
+        local[l] = 1;
+        completion[l] = 0.0;
+
+        // Lowest position of the switches of the team from each position onwards and
+        // of the switches of the team related to them (a position splits the sequence
+        // if it is the lowest one)
+        int lowest = base.offset[l + 1];
+        for (int g = base.offset[l + 1] - 1; g >= base.offset[l]; --g) {
+            int j = base.switches[g];
+            lowest = std::min(lowest, g);
+
+            for (int k : problem->predecessors_csr[j]) {
+                local[l] = (local[l] && team[k] == l);
+                lowest = (team[k] == l ? std::min(lowest, location[k]) : lowest);
+            }
+
+            for (int k : problem->successors_csr[j]) {
+                local[l] = (local[l] && team[k] == l);
+                lowest = (team[k] == l ? std::min(lowest, location[k]) : lowest);
+            }
+
+            split[g] = (g == base.offset[l] || lowest >= g);
+            completion[l] = std::max(completion[l], base.moments[g] + problem->p[j]);
+        }
+
+        // Prefix durations with the travel times of each team (the switches of the
+        // remote team do not travel)
+        for (int l_travel = (l != 0 ? 1 : 0); l_travel <= (l != 0 ? m : 0); ++l_travel) {
+            int last = 0;
+            double time = 0.0;
+            double* prefix = duration.data() + static_cast<std::size_t>(l_travel) * size;
+            for (int g = base.offset[l]; g < base.offset[l + 1]; ++g) {
+                int j = base.switches[g];
+                time += (l != 0 ? problem->c(last, j, l_travel) : 0.0) + problem->p[j];
+                prefix[g] = time;
+                last = j;
+            }
+        }
+    }
+
+    // Sort the teams by completion time (only used if the moments are up to date)
+    for (int l = 0; l <= m; ++l) {
+        latest[l] = l;
+    }
+
+    std::sort(latest.begin(), latest.end(), [this](int a, int b) {
+        return completion[a] > completion[b];
+    });
+}
+
+bool orcs::SegmentData::price_segment(int l_origin, int idx_origin, int length, int l_target, int idx_target,
+        double& makespan) const {
+
+    double time = 0.0;
+    int last = 0;
+
+    // Completion time of the origin team (and of the target team, if the same)
+    double completion1;
+    double completion2;
+    if (l_origin == l_target) {
+        int idx_end = idx_origin + length;
+        if (idx_target < idx_origin) {
+            append_range(time, last, l_origin, 0, idx_target, l_origin);
+            append_range(time, last, l_origin, idx_origin, idx_end, l_origin);
+            append_range(time, last, l_origin, idx_target, idx_origin, l_origin);
+            append_range(time, last, l_origin, idx_end, base->size(l_origin), l_origin);
+        } else {
+            append_range(time, last, l_origin, 0, idx_origin, l_origin);
+            append_range(time, last, l_origin, idx_end, idx_target + length, l_origin);
+            append_range(time, last, l_origin, idx_origin, idx_end, l_origin);
+            append_range(time, last, l_origin, idx_target + length, base->size(l_origin), l_origin);
+        }
+
+        completion1 = time;
+        completion2 = time;
+
+    } else {
+        append_range(time, last, l_origin, 0, idx_origin, l_origin);
+        append_range(time, last, l_origin, idx_origin + length, base->size(l_origin), l_origin);
+        completion1 = time;
+
+        // The segment is travelled by the target team
+        time = 0.0;
+        last = 0;
+        append_range(time, last, l_target, 0, idx_target, l_target);
+        for (int k = 0; k < length; ++k) {
+            int j = base->switch_at(l_origin, idx_origin + k);
+            time += problem->c(last, j, l_target) + problem->p[j];
+            last = j;
+        }
+
+        append_range(time, last, l_target, idx_target, base->size(l_target), l_target);
+        completion2 = time;
+    }
+
+    makespan = std::max(completion1, completion2);
+
+    // The price is exact if no switch of the teams changed waits for (or is waited
+    // by) a switch of another team and the switches of the segment have no
+    // precedence relation (so they can be placed anywhere)
+    int first = base->offset[l_origin] + idx_origin;
+    bool exact = feasible && local[l_origin] && local[l_target] && related[first + length] == related[first];
+    return conclude(exact, l_origin, l_target, makespan);
+}
+
+bool orcs::SegmentData::price_tails(int l1, int idx1, int l2, int idx2, double& makespan) const {
+
+    // Each tail is travelled by the other team
+    double time = 0.0;
+    int last = 0;
+    append_range(time, last, l1, 0, idx1, l1);
+    append_range(time, last, l2, idx2, base->size(l2), l1);
+    double completion1 = time;
+
+    time = 0.0;
+    last = 0;
+    append_range(time, last, l2, 0, idx2, l2);
+    append_range(time, last, l1, idx1, base->size(l1), l2);
+    double completion2 = time;
+
+    makespan = std::max(completion1, completion2);
+
+    // The price is exact if no switch of the teams waits for (or is waited by) a
+    // switch of another team, before and after the exchange, i.e., there is no
+    // precedence relation between the tails and the rest of their teams
+    bool exact = feasible && local[l1] && local[l2] &&
+                 split[base->offset[l1] + idx1] && split[base->offset[l2] + idx2];
+    return conclude(exact, l1, l2, makespan);
+}
+
+bool orcs::SegmentData::price_exchange(int l1, int idx1, int target1, int l2, int idx2, int target2,
+        double& makespan) const {
+
+    int j1 = base->switch_at(l1, idx1);
+    int j2 = base->switch_at(l2, idx2);
+    makespan = std::max(replace_completion(l1, idx1, j2, target2), replace_completion(l2, idx2, j1, target1));
+
+    // The price is exact under the same conditions of segment moves (the switches
+    // exchanged are segments of a single switch)
+    bool exact = feasible && local[l1] && local[l2] && isolated[j1] && isolated[j2];
+    return conclude(exact, l1, l2, makespan);
+}
+
+double orcs::SegmentData::replace_completion(int l, int idx, int j, int target) const {
+
+    // Completion time of team l without the switch at position idx and with switch j
+    // at position target (of the sequence without the switch removed)
+    double time = 0.0;
+    int last = 0;
+    int size = base->size(l);
+    if (target <= idx) {
+        append_range(time, last, l, 0, target, l);
+        time += problem->c(last, j, l) + problem->p[j];
+        last = j;
+        append_range(time, last, l, target, idx, l);
+        append_range(time, last, l, idx + 1, size, l);
+    } else {
+        append_range(time, last, l, 0, idx, l);
+        append_range(time, last, l, idx + 1, target + 1, l);
+        time += problem->c(last, j, l) + problem->p[j];
+        last = j;
+        append_range(time, last, l, target + 1, size, l);
+    }
+
+    return time;
+}
+
+void orcs::SegmentData::append_range(double& time, int& last, int l, int first, int end, int l_travel) const {
+    if (first < end) {
+        int g = base->offset[l] + first;
+        int h = g + (end - first) - 1;
+        const double* prefix = duration.data() + static_cast<std::size_t>(l_travel) * base->switches.size();
+        time += problem->c(last, base->switches[g], l_travel) + problem->p[base->switches[g]] + (prefix[h] - prefix[g]);
+        last = base->switches[h];
+    }
+}
+
+double orcs::SegmentData::completion_others(int l1, int l2) const {
+    for (int l : latest) {
+        if (l != l1 && l != l2) {
+            return completion[l];
+        }
+    }
+
+    return 0.0;
+}
+
+bool orcs::SegmentData::conclude(bool exact, int l1, int l2, double& makespan) const {
+
+    // With real times, the price is only a lower bound (lowered by the tolerance of the
+    // comparisons, so it remains one despite the rounding of the prefix differences)
+    if (!problem->integer_times) {
+        makespan -= utils::THRESHOLD;
+        return false;
+    }
+
+    // If exact, the makespan also depends on the teams not changed
+    if (exact) {
+        makespan = std::max(makespan, completion_others(l1, l2));
+    }
+
+    return exact;
+}
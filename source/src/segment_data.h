@@ -0,0 +1,141 @@
+#ifndef MANEUVERS_SCHEDULING_SEGMENT_DATA_H
+#define MANEUVERS_SCHEDULING_SEGMENT_DATA_H
+
+#include <vector>
+
+#include "flat_schedule.h"
+#include "problem.h"
+
+
+namespace orcs {
+
+    /**
+     * Segment data of a base schedule, used to price moves that relocate segments
+     * (contiguous subsequences, including single switches) of the sequences of the
+     * teams in constant time, without applying them. For each team, it keeps the
+     * duration of each prefix of its sequence when no switch waits for a precedence
+     * predecessor (i.e., the sum of the maneuver and travel times), so the duration
+     * of any segment is the difference of two prefixes. Since travel times depend
+     * on the team, the durations are kept for the travel times of every team.
+     *
+     * The completion time of a team computed from these durations is a lower bound
+     * on its actual completion time, since waiting only delays the switches. It is
+     * exact if the switches of the team have no precedence relation with switches
+     * of other teams, in which case the other teams are not affected by changes in
+     * its sequence either. Prices are only exact for instances with integer times
+     * (see Problem::integer_times): with real times, a difference of prefixes may
+     * differ in the last bits from the sum computed by the evaluation, so the price
+     * is lowered by a tolerance (utils::THRESHOLD) and used as a lower bound.
+     */
+    class SegmentData {
+
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param   problem
+         *          The instance of the problem the schedules belong to.
+         */
+        explicit SegmentData(const Problem& problem);
+
+        /**
+         * Load a base schedule.
+         *
+         * @param   base
+         *          The base schedule.
+         * @param   feasible
+         *          Whether the base schedule is feasible (i.e., its moments are
+         *          up to date). Exact prices require a feasible base schedule.
+         */
+        void load(const FlatSchedule& base, bool feasible);
+
+        /**
+         * Price the move of the segment of the given length that starts at position
+         * idx_origin of team l_origin to position idx_target of team l_target (which
+         * refers to the sequence of team l_target without the segment, as in
+         * FlatSchedule::move). The move is not applied.
+         *
+         * @param   makespan
+         *          The makespan of the neighbor, if the price is exact, or a lower
+         *          bound on it, otherwise.
+         * @return  True if the price is exact (in which case the neighbor is
+         *          feasible), false otherwise.
+         */
+        bool price_segment(int l_origin, int idx_origin, int length, int l_target, int idx_target,
+                double& makespan) const;
+
+        /**
+         * Price the exchange of the tails of the sequences of teams l1 and l2 from
+         * positions idx1 and idx2, respectively (see FlatSchedule::exchange_tails).
+         * The move is not applied.
+         *
+         * @param   makespan
+         *          The makespan of the neighbor, if the price is exact, or a lower
+         *          bound on it, otherwise.
+         * @return  True if the price is exact (in which case the neighbor is
+         *          feasible), false otherwise.
+         */
+        bool price_tails(int l1, int idx1, int l2, int idx2, double& makespan) const;
+
+        /**
+         * Price the exchange of the switches at position idx1 of team l1 and at
+         * position idx2 of team l2 (l1 != l2), in which the first one is inserted at
+         * position target1 of team l2 and the second one at position target2 of team
+         * l1 (see FlatSchedule::exchange). The move is not applied.
+         *
+         * @param   makespan
+         *          The makespan of the neighbor, if the price is exact, or a lower
+         *          bound on it, otherwise.
+         * @return  True if the price is exact (in which case the neighbor is
+         *          feasible), false otherwise.
+         */
+        bool price_exchange(int l1, int idx1, int target1, int l2, int idx2, int target2, double& makespan) const;
+
+    private:
+
+        void append_range(double& time, int& last, int l, int first, int end, int l_travel) const;
+
+        double replace_completion(int l, int idx, int j, int target) const;
+
+        double completion_others(int l1, int l2) const;
+
+        bool conclude(bool exact, int l1, int l2, double& makespan) const;
+
+        const Problem* problem;
+        const FlatSchedule* base;
+        bool feasible;
+
+        // Switches with no precedence relation
+        std::vector<char> isolated;
+
+        // Number of switches with precedence relations before each position of the
+        // giant tour of the base schedule
+        std::vector<int> related;
+
+        // Teams whose switches have no precedence relation with switches of other
+        // teams, their completion times (from the moments of the base schedule) and
+        // the teams sorted by decreasing completion time
+        std::vector<char> local;
+        std::vector<double> completion;
+        std::vector<int> latest;
+
+        // Positions of the giant tour that split the sequence of their team into two
+        // parts with no precedence relation between them
+        std::vector<char> split;
+
+        // Duration of the prefix of the sequence of each team up to each position of
+        // the giant tour (including the travel from the origin) with the travel times
+        // of team l, indexed by l * (size of the giant tour) + position
+        std::vector<double> duration;
+
+        // Team and position (in the giant tour) of each switch in the base schedule
+        std::vector<int> team;
+        std::vector<int> location;
+
+    };
+
+}
+
+
+#endif
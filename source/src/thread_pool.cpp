@@ -0,0 +1,75 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+
+orcs::ThreadPool::ThreadPool(int n_threads) :
+        n_workers(n_threads > 0 ? n_threads : std::max(1, static_cast<int>(std::thread::hardware_concurrency()))) {
+
+    for (int worker = 1; worker < n_workers; ++worker) {
+        threads.emplace_back(&ThreadPool::loop, this, worker);
+    }
+}
+
+orcs::ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+
+    started.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void orcs::ThreadPool::run(const std::function<void(int)>& task) {
+
+    // Wake up the threads
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->task = &task;
+        pending = n_workers - 1;
+        ++generation;
+    }
+
+    started.notify_all();
+
+    // The calling thread works as worker 0
+    task(0);
+
+    // Wait for the other workers
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this]() { return pending == 0; });
+    this->task = nullptr;
+}
+
+void orcs::ThreadPool::loop(int worker) {
+
+    long last_generation = 0;
+    while (true) {
+
+        // Wait for a new task (or for the pool to stop)
+        const std::function<void(int)>* current = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            started.wait(lock, [this, last_generation]() { return stopping || generation != last_generation; });
+            if (stopping) {
+                return;
+            }
+
+            last_generation = generation;
+            current = task;
+        }
+
+        (*current)(worker);
+
+        // Notify the calling thread
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --pending;
+        }
+
+        finished.notify_one();
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef MANEUVERS_SCHEDULING_THREAD_POOL_H
+#define MANEUVERS_SCHEDULING_THREAD_POOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace orcs {
+
+    /**
+     * A fixed set of worker threads that run the same task together. The
+     * threads are created once and wait for tasks, so running a task does not
+     * create threads. The calling thread works as worker 0.
+     */
+    class ThreadPool {
+
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param   n_threads
+         *          Number of workers (including the calling thread). If set to 0
+         *          (zero), all threads available are used.
+         */
+        explicit ThreadPool(int n_threads);
+
+        /**
+         * Destructor. Waits for the threads to finish.
+         */
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * Return the number of workers.
+         */
+        inline int size() const {
+            return n_workers;
+        }
+
+        /**
+         * Run a task on all workers and wait for them to finish. Each worker calls
+         * task(w), in which w is the index of the worker (from 0 to size()-1).
+         *
+         * @param   task
+         *          The task to run.
+         */
+        void run(const std::function<void(int)>& task);
+
+    private:
+
+        void loop(int worker);
+
+        int n_workers;
+        std::vector<std::thread> threads;
+
+        std::mutex mutex;
+        std::condition_variable started;
+        std::condition_variable finished;
+        const std::function<void(int)>* task = nullptr;
+        long generation = 0;
+        int pending = 0;
+        bool stopping = false;
+
+    };
+
+}
+
+
+#endif
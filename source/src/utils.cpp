@@ -1,8 +1,116 @@
 #include "utils.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 
+/**
+ * Full evaluation of a schedule (see orcs::utils::evaluate) with the moments of the
+ * switches computed in the time type T of the instance.
+ */
+template <class T>
+static orcs::EvaluationStatus evaluate_times(const orcs::Problem& problem, std::tuple<orcs::Schedule, double>& entry,
+        orcs::EvaluationContext& context, std::vector<T>& t, double bound) {
+
+    // Get the schedule and makespan
+    orcs::Schedule& schedule = std::get<orcs::Schedule>(entry);
+    double& makespan = std::get<double>(entry);
+
+    // Makespan of the switches done so far
+    T makespan_schedule = 0;
+
+    // Data structures used for checking feasibility and fixing the operation moments
+    std::vector<int>& team = context.team;          // team each switch is assigned to
+    std::vector<int>& position = context.position;  // position of each switch in its team's sequence
+    std::vector<int>& pendings = context.pendings;  // number of pending predecessors (team and precedence)
+    std::vector<int>& ready = context.ready;        // switches whose predecessors are all done
+    ready.clear();
+
+    // The teams leave the origin (switch 0) at moment 0
+    t[0] = 0;
+
+    for (int l = 0; l <= problem.m; ++l) {
+        for (int idx = 0; idx < schedule[l].size(); ++idx) {
+            int j = std::get<orcs::ATTR_SWITCH>(schedule[l][idx]);
+            team[j] = l;
+            position[j] = idx;
+            pendings[j] = problem.predecessors_csr[j].size() + (idx > 0 ? 1 : 0);
+            std::get<orcs::ATTR_MOMENT>(schedule[l][idx]) = std::numeric_limits<double>::max();
+
+            // The head of a team with no pending precedence is ready
+            if (pendings[j] == 0) {
+                ready.push_back(j);
+            }
+        }
+    }
+
+    // Analyse the solution: switches are processed as soon as they become ready (i.e.,
+    // their team predecessor and all their precedence predecessors are done)
+    int n_done = 0;
+    for (std::size_t head = 0; head < ready.size(); ++head) {
+
+        // Get the switch and its location in the schedule
+        int j = ready[head];
+        int l = team[j];
+        int idx = position[j];
+
+        // Compute the operation moment
+        if (l != 0) {
+            int i = (idx > 0 ? std::get<orcs::ATTR_SWITCH>(schedule[l][idx - 1]) : 0);
+            t[j] = t[i] + problem.maneuver_time<T>(i) + problem.travel_time<T>(i, j, l);
+        } else {
+            t[j] = 0;
+        }
+
+        // Check the precedence constraints
+        for (auto k : problem.predecessors_csr[j]) {
+            t[j] = std::max(t[j], t[k] + problem.maneuver_time<T>(k));
+        }
+
+        // Fix the operation moment in the schedule
+        std::get<orcs::ATTR_MOMENT>(schedule[l][idx]) = t[j];
+
+        // Update the makespan
+        makespan_schedule = std::max(makespan_schedule, t[j] + problem.maneuver_time<T>(j));
+
+        // Abort if the makespan reaches the bound
+        if (makespan_schedule >= bound) {
+            makespan = std::numeric_limits<double>::max();
+            return orcs::EvaluationStatus::DOMINATED;
+        }
+
+        // Notify the successors (team and precedence)
+        if (idx + 1 < schedule[l].size()) {
+            int s = std::get<orcs::ATTR_SWITCH>(schedule[l][idx + 1]);
+            if (--pendings[s] == 0) {
+                ready.push_back(s);
+            }
+        }
+
+        for (auto s : problem.successors_csr[j]) {
+            if (--pendings[s] == 0) {
+                ready.push_back(s);
+            }
+        }
+
+        // Increment the number of switch operations analysed
+        ++n_done;
+    }
+
+    // If the queue gets empty before all switches are done, there is a deadlock
+    bool feasibility = (n_done == problem.n);
+
+    // If not feasible, makespan is set to infinity
+    if (!feasibility) {
+        makespan = std::numeric_limits<double>::max();
+        return orcs::EvaluationStatus::INFEASIBLE;
+    }
+
+    makespan = makespan_schedule;
+    return orcs::EvaluationStatus::FEASIBLE;
+}
+
 int orcs::utils::compare(double first, double second) {
     return std::abs(first - second) < THRESHOLD ? 0 : (first < second ? -1 : 1);
 }
@@ -27,89 +135,65 @@ bool orcs::utils::is_lower_equal(double first, double second) {
     return compare(first, second) != 1;
 }
 
-bool orcs::utils::evaluate(const orcs::Problem& problem, std::tuple<orcs::Schedule, double>& entry) {
-
-    // Get the schedule and makespan
-    Schedule& schedule = std::get<Schedule>(entry);
-    double& makespan = std::get<double>(entry);
-
-    // Reset the makespan
-    makespan = 0.0;
+orcs::utils::RandomPermutation::RandomPermutation(std::uint64_t size, std::mt19937& generator) :
+        n_elements(size) {
 
-    // Data structures used for checking feasibility and fixing the operation moments
-    std::vector<int> index(problem.m + 1, 0);       // next index to analyse of each schedule
-    std::vector<int> location(problem.m + 1, 0);    // current location of each team
-    std::vector<int> pendings(problem.n + 1, 0);    // number of pending predecessors switch operations
-    std::vector<double*> t(problem.n + 1, nullptr); // new operation moment (fixed)
-
-    double t0 = 0.0;
-    t[0] = &t0;
-
-    for (int l = 0; l <= problem.m; ++l) {
-        for (int idx = 0; idx < schedule[l].size(); ++idx) {
-            pendings[std::get<ATTR_SWITCH>(schedule[l][idx])] = problem.predecessors[std::get<ATTR_SWITCH>(schedule[l][idx])].size();
-            t[std::get<ATTR_SWITCH>(schedule[l][idx])] = &std::get<ATTR_MOMENT>(schedule[l][idx]);
-            *t[std::get<ATTR_SWITCH>(schedule[l][idx])] = std::numeric_limits<double>::max();
-        }
+    // Number of bits required to represent the elements
+    int bits = 0;
+    while (bits < 64 && (std::uint64_t(1) << bits) < size) {
+        ++bits;
     }
 
-    // Presuppose the solution is feasible
-    bool feasibility = true;
-
-    // Analyse the solution
-    int n_done = 0;
-    while (n_done < problem.n && feasibility) {
-
-        feasibility = false;
-        for (int l = 0; l <= problem.m; ++l) {
-            if (index[l] < schedule[l].size()) {
+    mask = (bits < 64 ? (std::uint64_t(1) << bits) - 1 : ~std::uint64_t(0));
+    shift = bits / 2 + 1;
 
-                // Get the switch
-                int j = std::get<ATTR_SWITCH>(schedule[l][index[l]]);
+    // Random affine maps modulo 2^bits (odd multipliers make them bijective)
+    for (int round = 0; round < 2; ++round) {
+        multiplier[round] = ((std::uint64_t(generator()) << 32) | generator()) | 1;
+        increment[round] = (std::uint64_t(generator()) << 32) | generator();
+    }
+}
 
-                if (pendings[j] == 0) {
+std::uint64_t orcs::utils::RandomPermutation::operator()(std::uint64_t k) const {
 
-                    // Get the current location of the team
-                    int i = location[l];
+    // Walk the cycle of k until an element of the permutation is found
+    std::uint64_t x = scramble(k);
+    while (x >= n_elements) {
+        x = scramble(x);
+    }
 
-                    // Compute the operation moment
-                    if (l != 0) {
-                        *t[j] = *t[i] + problem.p[i] + problem.c[i][j][l];
-                    } else {
-                        *t[j] = 0.0;
-                    }
+    return x;
+}
 
-                    // Check the precedence constraints
-                    for (auto k : problem.predecessors[j]) {
-                        *t[j] = std::max(*t[j], *t[k] + problem.p[k]);
-                    }
+std::uint64_t orcs::utils::RandomPermutation::scramble(std::uint64_t x) const {
 
-                    // Update the pending counters
-                    for (auto k : problem.successors[j]) {
-                        --pendings[k];
-                    }
+    // Composition of bijections on the integers from 0 to mask
+    for (int round = 0; round < 2; ++round) {
+        x = (x * multiplier[round] + increment[round]) & mask;
+        x ^= (x >> shift);
+    }
 
-                    // Update the makespan
-                    makespan = std::max(makespan, *t[j] + problem.p[j]);
+    return x;
+}
 
-                    // Update the index and team's location
-                    ++index[l];
-                    location[l] = j;
+bool orcs::utils::evaluate(const orcs::Problem& problem, std::tuple<orcs::Schedule, double>& entry) {
+    EvaluationContext context(problem);
+    return evaluate(problem, entry, context);
+}
 
-                    // Increment the number of switch operations analysed
-                    ++n_done;
+bool orcs::utils::evaluate(const orcs::Problem& problem, std::tuple<orcs::Schedule, double>& entry,
+        orcs::EvaluationContext& context) {
+    return evaluate(problem, entry, context, std::numeric_limits<double>::max()) == EvaluationStatus::FEASIBLE;
+}
 
-                    // The solution is feasible so far
-                    feasibility = true;
-                }
-            }
-        }
-    }
+orcs::EvaluationStatus orcs::utils::evaluate(const orcs::Problem& problem,
+        std::tuple<orcs::Schedule, double>& entry, orcs::EvaluationContext& context, double bound) {
 
-    // If not feasible, makespan is set to infinity
-    if (!feasibility) {
-        makespan = std::numeric_limits<double>::max();
+    // The time type of the instance is chosen once per evaluation (exact integer
+    // arithmetic, if the times of the instance are integer values)
+    if (problem.integer_times) {
+        return evaluate_times(problem, entry, context, context.integer_moment, bound);
+    } else {
+        return evaluate_times(problem, entry, context, context.real_moment, bound);
     }
-
-    return feasibility;
 }
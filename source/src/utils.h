@@ -2,11 +2,13 @@
 #define MANEUVERS_SCHEDULING_UTILS_H
 
 #include <cstddef>
+#include <cstdint>
 #include <random>
 #include <string>
 #include <tuple>
 #include <type_traits>
 
+#include "evaluator.h"
 #include "problem.h"
 
 
@@ -139,9 +141,58 @@ namespace orcs {
         template <class TObject, template<class, class...> class TContainer1, template<class, class...> class TContainer2, class TRandom>
         std::tuple<TObject, std::size_t> choose(const TContainer1<TObject>& values, const TContainer2<double>& weights, TRandom& generator);
 
+        /**
+         * A pseudo-random permutation of the integers from 0 to size-1. The k-th element of the
+         * permutation is computed on demand (in constant expected time and memory), so the
+         * elements of a large set can be visited in random order without storing them. It
+         * applies a random bijection to the smallest power of two not less than size and
+         * repeats it (cycle walking) until the result is lower than size.
+         */
+        class RandomPermutation {
+
+        public:
+
+            /**
+             * Constructor.
+             *
+             * @param   size
+             *          The number of elements of the permutation.
+             * @param   generator
+             *          The random number generator used to draw the permutation.
+             */
+            RandomPermutation(std::uint64_t size, std::mt19937& generator);
+
+            /**
+             * Return the number of elements of the permutation.
+             */
+            inline std::uint64_t size() const {
+                return n_elements;
+            }
+
+            /**
+             * Return the k-th element of the permutation.
+             */
+            std::uint64_t operator()(std::uint64_t k) const;
+
+        private:
+
+            std::uint64_t scramble(std::uint64_t x) const;
+
+            std::uint64_t n_elements;
+            std::uint64_t mask;
+            int shift;
+            std::uint64_t multiplier[2];
+            std::uint64_t increment[2];
+
+        };
+
         /**
          * Evaluate a scheduling and updates the entry with the result of the evaluation. Besides,
-         * it returns whether the scheduling is feasible or not.
+         * it returns whether the scheduling is feasible or not. The switches are processed in
+         * the order they become ready (i.e., their team predecessor and precedence predecessors
+         * are done), so the evaluation runs in linear time on the number of switches and
+         * precedence arcs. A deadlock (infeasible schedule) is detected as soon as no switch
+         * is ready.
          *
          * @param   problem
          * @param   entry
@@ -149,6 +200,36 @@ namespace orcs {
          */
         bool evaluate(const Problem& problem, std::tuple<Schedule, double>& entry);
 
+        /**
+         * Evaluate a scheduling and updates the entry with the result of the evaluation. Besides,
+         * it returns whether the scheduling is feasible or not. This version uses the data
+         * structures of the given context, so no memory is allocated.
+         *
+         * @param   problem
+         * @param   entry
+         * @param   context
+         * @return
+         */
+        bool evaluate(const Problem& problem, std::tuple<Schedule, double>& entry,
+                EvaluationContext& context);
+
+        /**
+         * Evaluate a scheduling bounded by an upper bound on the makespan. The evaluation
+         * is aborted as soon as the completion time of any switch reaches the bound, since
+         * the schedule cannot be better than the one the bound comes from (e.g., the
+         * incumbent solution).
+         *
+         * @param   problem
+         * @param   entry
+         * @param   context
+         * @param   bound
+         * @return  FEASIBLE if the schedule is feasible and its makespan is lower than the
+         *          bound, DOMINATED if the evaluation has been aborted due to the bound or
+         *          INFEASIBLE otherwise.
+         */
+        EvaluationStatus evaluate(const Problem& problem, std::tuple<Schedule, double>& entry,
+                EvaluationContext& context, double bound);
+
     }
 
 }
@@ -0,0 +1,71 @@
+#include "visited_cache.h"
+
+
+/**
+ * Check whether two schedules have the same sequences of switches (the moments
+ * are ignored).
+ */
+static bool same_sequences(const orcs::Schedule& a, const orcs::Schedule& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+
+    for (std::size_t l = 0; l < a.size(); ++l) {
+        if (a[l].size() != b[l].size()) {
+            return false;
+        }
+
+        for (std::size_t idx = 0; idx < a[l].size(); ++idx) {
+            if (std::get<orcs::ATTR_SWITCH>(a[l][idx]) != std::get<orcs::ATTR_SWITCH>(b[l][idx])) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+orcs::VisitedCache::VisitedCache(std::size_t capacity) :
+        capacity(capacity) {
+
+    positions.reserve(capacity);
+}
+
+const std::tuple<orcs::Schedule, double>* orcs::VisitedCache::find(std::uint64_t key, const Schedule& start) {
+
+    auto position = positions.find(key);
+    if (position == positions.end() || !same_sequences(position->second->start, start)) {
+        ++misses;
+        return nullptr;
+    }
+
+    // The entry becomes the most recently used one
+    entries.splice(entries.begin(), entries, position->second);
+    ++hits;
+    return &(entries.front().result);
+}
+
+void orcs::VisitedCache::insert(std::uint64_t key, const Schedule& start,
+        const std::tuple<Schedule, double>& result) {
+
+    if (capacity == 0) {
+        return;
+    }
+
+    // An entry with the same hash is replaced (it is the same start solution or a
+    // collision)
+    auto position = positions.find(key);
+    if (position != positions.end()) {
+        entries.erase(position->second);
+        positions.erase(position);
+    }
+
+    // Release the least recently used entry, if full
+    if (entries.size() >= capacity) {
+        positions.erase(entries.back().key);
+        entries.pop_back();
+    }
+
+    entries.push_front(Entry{key, start, result});
+    positions[key] = entries.begin();
+}
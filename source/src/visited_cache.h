@@ -0,0 +1,82 @@
+#ifndef MANEUVERS_SCHEDULING_VISITED_CACHE_H
+#define MANEUVERS_SCHEDULING_VISITED_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <tuple>
+#include <unordered_map>
+
+#include "problem.h"
+
+
+namespace orcs {
+
+    /**
+     * Bounded cache of the local searches performed, which maps the hash (see
+     * ScheduleHash) of a start solution to the local optimum found from it, so a
+     * repeated local search becomes a lookup. Local optima may also be stored as
+     * start solutions (mapped to themselves). The start solution is stored with
+     * its hash and compared on lookup, so a collision is a miss. When full, the
+     * least recently used entry is replaced. It is not thread safe (e.g., each
+     * trajectory of the ILS has its own cache).
+     */
+    class VisitedCache {
+
+    public:
+
+        /**
+         * Constructor. Creates an empty cache.
+         *
+         * @param   capacity
+         *          The maximum number of entries.
+         */
+        explicit VisitedCache(std::size_t capacity);
+
+        /**
+         * Return the local optimum found from a start solution, or nullptr if it is
+         * not in the cache. It remains valid until the next insertion.
+         *
+         * @param   key
+         *          The hash of the start solution.
+         * @param   start
+         *          The start solution.
+         */
+        const std::tuple<Schedule, double>* find(std::uint64_t key, const Schedule& start);
+
+        /**
+         * Store the local optimum found from a start solution.
+         *
+         * @param   key
+         *          The hash of the start solution.
+         * @param   start
+         *          The start solution.
+         * @param   result
+         *          The local optimum, as a tuple of the schedule and the makespan.
+         */
+        void insert(std::uint64_t key, const Schedule& start, const std::tuple<Schedule, double>& result);
+
+        long hits = 0;
+        long misses = 0;
+
+    private:
+
+        struct Entry {
+            std::uint64_t key;
+            Schedule start;
+            std::tuple<Schedule, double> result;
+        };
+
+        std::size_t capacity;
+
+        // Entries from the most recently used to the least recently used one, and
+        // their positions by hash
+        std::list<Entry> entries;
+        std::unordered_map<std::uint64_t, std::list<Entry>::iterator> positions;
+
+    };
+
+}
+
+
+#endif
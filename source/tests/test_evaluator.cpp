@@ -0,0 +1,124 @@
+#include <random>
+#include <string>
+#include <tuple>
+
+#include "evaluator.h"
+#include "flat_schedule.h"
+#include "move.h"
+#include "problem.h"
+#include "search_context.h"
+#include "test_utils.h"
+
+
+/**
+ * Check that the incremental evaluation of the neighbors of a base schedule agrees
+ * with their evaluation from scratch, with and without an upper bound.
+ */
+static void test_delta_evaluation(const orcs::Problem& problem, std::mt19937& generator) {
+
+    orcs::SearchContext context(problem);
+    for (auto& entry : orcs::tests::base_schedules(problem, context, generator)) {
+
+        orcs::DeltaEvaluator& evaluator = context.delta;
+        bool feasible = evaluator.load(entry);
+        orcs::tests::check(feasible, "the base schedule is feasible");
+
+        // The moments of the base schedule are the ones of the full evaluation
+        double makespan;
+        orcs::tests::evaluate(problem, evaluator.base(), context, makespan);
+        orcs::tests::check(orcs::tests::same_makespan(problem, makespan, std::get<double>(entry)),
+                "the full evaluation keeps the makespan of the base schedule");
+
+        const double bound = std::get<double>(entry);
+        for (auto type : orcs::tests::move_types()) {
+            orcs::MoveSpace movements(type, evaluator.base());
+            orcs::FlatSchedule working = evaluator.base();
+
+            for (auto k : orcs::tests::sample(movements.size(), 300, generator)) {
+                orcs::Move move = movements[k];
+                move.apply(working);
+
+                double full_makespan;
+                bool full_feasible = orcs::tests::evaluate(problem, working, context, full_makespan);
+
+                // Without a bound, the status and makespan match the full evaluation
+                double delta_makespan = -1.0;
+                orcs::EvaluationStatus status = move.evaluate(evaluator, working, delta_makespan);
+                orcs::tests::check((status == orcs::EvaluationStatus::FEASIBLE) == full_feasible,
+                        "delta and full evaluations agree on the feasibility");
+                if (full_feasible && status == orcs::EvaluationStatus::FEASIBLE) {
+                    orcs::tests::check(orcs::tests::same_makespan(problem, delta_makespan, full_makespan),
+                            "delta and full evaluations agree on the makespan");
+                }
+
+                // With a bound, only the neighbors better than the bound are feasible
+                status = move.evaluate(evaluator, working, delta_makespan, bound);
+                bool better = full_feasible && full_makespan < bound;
+                orcs::tests::check((status == orcs::EvaluationStatus::FEASIBLE) == better,
+                        "the bounded delta evaluation only accepts the improving neighbors");
+                if (better && status == orcs::EvaluationStatus::FEASIBLE) {
+                    orcs::tests::check(orcs::tests::same_makespan(problem, delta_makespan, full_makespan),
+                            "the bounded delta evaluation keeps the makespan");
+                }
+
+                move.undo(working);
+            }
+        }
+    }
+}
+
+/**
+ * Check that the moments stored by the incremental evaluation of a neighbor are the
+ * ones computed by its evaluation from scratch.
+ */
+static void test_stored_moments(const orcs::Problem& problem, std::mt19937& generator) {
+
+    orcs::SearchContext context(problem);
+    for (auto& entry : orcs::tests::base_schedules(problem, context, generator)) {
+        orcs::DeltaEvaluator& evaluator = context.delta;
+        evaluator.load(entry);
+
+        for (auto type : orcs::tests::move_types()) {
+            orcs::MoveSpace movements(type, evaluator.base());
+            for (auto k : orcs::tests::sample(movements.size(), 50, generator)) {
+                orcs::FlatSchedule working = evaluator.base();
+                std::tuple<orcs::Schedule, double> neighbor = movements[k].materialize(evaluator, working);
+
+                std::tuple<orcs::Schedule, double> full = neighbor;
+                if (!orcs::utils::evaluate(problem, full, context.evaluation)) {
+                    continue;
+                }
+
+                const orcs::Schedule& schedule = std::get<orcs::Schedule>(neighbor);
+                for (int l = 0; l <= problem.m; ++l) {
+                    for (int idx = 0; idx < static_cast<int>(schedule[l].size()); ++idx) {
+                        orcs::tests::check(orcs::tests::same_makespan(problem,
+                                std::get<orcs::ATTR_MOMENT>(schedule[l][idx]),
+                                std::get<orcs::ATTR_MOMENT>(std::get<orcs::Schedule>(full)[l][idx])),
+                                "the stored moments match the full evaluation");
+                    }
+                }
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+
+    std::string directory = (argc > 1 ? argv[1] : "instances/benchmark");
+    std::mt19937 generator(0);
+
+    for (auto& path : orcs::tests::instances(directory)) {
+        for (bool fractional : {false, true}) {
+            orcs::Problem problem(path);
+            if (fractional) {
+                orcs::tests::make_fractional(problem);
+            }
+
+            test_delta_evaluation(problem, generator);
+            test_stored_moments(problem, generator);
+        }
+    }
+
+    return orcs::tests::report("test_evaluator");
+}
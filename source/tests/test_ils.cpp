@@ -0,0 +1,122 @@
+#include <memory>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <cxxproperties.hpp>
+
+#include "heur_greedy.h"
+#include "heur_ils.h"
+#include "neighborhood.h"
+#include "problem.h"
+#include "search_context.h"
+#include "test_utils.h"
+#include "thread_pool.h"
+
+
+/**
+ * Return one instance of each neighborhood.
+ */
+static std::vector<std::unique_ptr<orcs::Neighborhood>> neighborhoods() {
+    std::vector<std::unique_ptr<orcs::Neighborhood>> result;
+    result.emplace_back(new orcs::Shift());
+    result.emplace_back(new orcs::Reassignement());
+    result.emplace_back(new orcs::Swap());
+    result.emplace_back(new orcs::PairSwap());
+    result.emplace_back(new orcs::OrOpt());
+    result.emplace_back(new orcs::TailExchange());
+    return result;
+}
+
+/**
+ * Check that the threads used to scan a neighborhood do not change the move it
+ * selects: the best neighbor found by one thread and by several threads must be the
+ * same schedule (the lowest move index wins among the moves of equal makespan).
+ */
+static void test_same_move(const orcs::Problem& problem, std::mt19937& generator) {
+
+    orcs::ThreadPool pool(4);
+    orcs::SearchContext sequential(problem);
+    orcs::SearchContext parallel(problem);
+    parallel.set_thread_pool(&pool);
+
+    auto sequential_neighborhoods = neighborhoods();
+    auto parallel_neighborhoods = neighborhoods();
+
+    // Schedules far from local optima, whose neighborhoods have many improving moves
+    // (so the workers often find moves of equal makespan)
+    std::vector<std::tuple<orcs::Schedule, double>> schedules;
+    orcs::Reassignement reassignment;
+    orcs::Swap swap;
+    orcs::Neighborhood* perturbations[] = {&reassignment, &swap};
+    std::tuple<orcs::Schedule, double> start = orcs::Greedy().solve(problem);
+    for (int k = 0; k < 20; ++k) {
+        std::tuple<orcs::Schedule, double> entry = start;
+        for (int pass = 0; pass < 30; ++pass) {
+            entry = perturbations[pass % 2]->shake(problem, entry, true, sequential, generator);
+        }
+
+        schedules.push_back(entry);
+    }
+
+    for (auto& entry : schedules) {
+        for (std::size_t k = 0; k < sequential_neighborhoods.size(); ++k) {
+            orcs::Neighborhood* first = sequential_neighborhoods[k].get();
+            orcs::Neighborhood* second = parallel_neighborhoods[k].get();
+
+            std::tuple<orcs::Schedule, double> expected = first->best_improvement(problem, entry, sequential);
+            std::tuple<orcs::Schedule, double> found = second->best_improvement(problem, entry, parallel);
+            orcs::tests::check(std::get<double>(expected) == std::get<double>(found),
+                    "the number of threads keeps the makespan of the best neighbor");
+            orcs::tests::check(std::get<orcs::Schedule>(expected) == std::get<orcs::Schedule>(found),
+                    "the number of threads keeps the best neighbor");
+        }
+    }
+}
+
+/**
+ * Check that the threads do not change the result of the ILS: with the same seed, the
+ * search with one thread and the search with several threads return the same schedule.
+ */
+static void test_same_result(const orcs::Problem& problem, const cxxproperties::Properties& parameters) {
+
+    std::vector<std::tuple<orcs::Schedule, double>> results;
+    for (int threads : {1, 4}) {
+        cxxproperties::Properties input = parameters;
+        input.add("threads", threads);
+
+        orcs::ILS ils;
+        results.push_back(ils.solve(problem, &input, nullptr));
+    }
+
+    orcs::tests::check(problem.is_feasible(std::get<orcs::Schedule>(results[0])),
+            "the ILS returns a feasible schedule");
+    orcs::tests::check(std::get<double>(results[0]) == std::get<double>(results[1]),
+            "the number of threads keeps the makespan of the ILS");
+    orcs::tests::check(std::get<orcs::Schedule>(results[0]) == std::get<orcs::Schedule>(results[1]),
+            "the number of threads keeps the schedule of the ILS");
+}
+
+int main(int argc, char** argv) {
+
+    std::string directory = (argc > 1 ? argv[1] : "instances/benchmark");
+    std::mt19937 generator(0);
+
+    // Short searches with the extended neighborhoods
+    cxxproperties::Properties parameters;
+    parameters.add("seed", 0u);
+    parameters.add("iterations-limit", 10L);
+    parameters.add("perturbation-passes-limit", 5L);
+    parameters.add("or-opt", true);
+    parameters.add("tail-exchange", true);
+    parameters.add("pair-swap", true);
+
+    for (auto& path : orcs::tests::instances(directory)) {
+        orcs::Problem problem(path);
+        test_same_move(problem, generator);
+        test_same_result(problem, parameters);
+    }
+
+    return orcs::tests::report("test_ils");
+}
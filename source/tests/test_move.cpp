@@ -0,0 +1,106 @@
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "evaluator.h"
+#include "flat_schedule.h"
+#include "move.h"
+#include "move_filter.h"
+#include "problem.h"
+#include "search_context.h"
+#include "test_utils.h"
+
+
+/**
+ * Check that undoing a move restores the base schedule and that the neighbor keeps
+ * every switch exactly once.
+ */
+static void test_apply_undo(const orcs::Problem& problem, std::mt19937& generator) {
+
+    orcs::SearchContext context(problem);
+    for (auto& entry : orcs::tests::base_schedules(problem, context, generator)) {
+        const orcs::FlatSchedule base(std::get<orcs::Schedule>(entry));
+
+        for (auto type : orcs::tests::move_types()) {
+            orcs::MoveSpace movements(type, base);
+            orcs::FlatSchedule working = base;
+
+            for (auto k : orcs::tests::sample(movements.size(), 500, generator)) {
+                orcs::Move move = movements[k];
+                move.apply(working);
+
+                // Each switch is scheduled once, in a team of its technology
+                std::vector<int> count(problem.n + 1, 0);
+                for (int l = 0; l <= problem.m; ++l) {
+                    for (int idx = 0; idx < working.size(l); ++idx) {
+                        int j = working.switch_at(l, idx);
+                        ++count[j];
+                        orcs::tests::check((l == 0) == (problem.technology[j] == orcs::Technology::REMOTE),
+                                "the move keeps the switches in teams of their technology");
+                    }
+                }
+
+                for (int j = 1; j <= problem.n; ++j) {
+                    orcs::tests::check(count[j] == 1, "the move keeps every switch once");
+                }
+
+                orcs::tests::check(working.switches != base.switches || working.offset != base.offset,
+                        "the move changes the schedule");
+
+                move.undo(working);
+                orcs::tests::check(working.switches == base.switches && working.offset == base.offset,
+                        "undoing the move restores the base schedule");
+            }
+        }
+    }
+}
+
+/**
+ * Check that the move filter only rejects moves that lead to infeasible schedules.
+ */
+static void test_filter_soundness(const orcs::Problem& problem, std::mt19937& generator) {
+
+    orcs::SearchContext context(problem);
+    long rejected = 0;
+    for (auto& entry : orcs::tests::base_schedules(problem, context, generator)) {
+        orcs::MoveFilter& filter = context.filter;
+        filter.load(entry);
+
+        const orcs::FlatSchedule base(std::get<orcs::Schedule>(entry));
+        for (auto type : orcs::tests::move_types()) {
+            orcs::MoveSpace movements(type, base);
+            orcs::FlatSchedule working = base;
+
+            for (auto k : orcs::tests::sample(movements.size(), 500, generator)) {
+                orcs::Move move = movements[k];
+                if (move.accept(filter, base)) {
+                    continue;
+                }
+
+                ++rejected;
+                move.apply(working);
+                double makespan;
+                orcs::tests::check(!orcs::tests::evaluate(problem, working, context, makespan),
+                        "the move filter only rejects infeasible neighbors");
+                move.undo(working);
+            }
+        }
+    }
+
+    orcs::tests::check(rejected > 0, "the move filter rejects some moves");
+}
+
+int main(int argc, char** argv) {
+
+    std::string directory = (argc > 1 ? argv[1] : "instances/benchmark");
+    std::mt19937 generator(0);
+
+    for (auto& path : orcs::tests::instances(directory)) {
+        orcs::Problem problem(path);
+        test_apply_undo(problem, generator);
+        test_filter_soundness(problem, generator);
+    }
+
+    return orcs::tests::report("test_move");
+}
@@ -0,0 +1,99 @@
+#include <random>
+#include <string>
+#include <tuple>
+
+#include "evaluator.h"
+#include "flat_schedule.h"
+#include "move.h"
+#include "problem.h"
+#include "search_context.h"
+#include "segment_data.h"
+#include "test_utils.h"
+
+
+/**
+ * Check the prices of the moves: an exact price is the makespan of a feasible
+ * neighbor, and any other price is a lower bound on the makespan of the neighbor.
+ */
+static void test_prices(const orcs::Problem& problem, std::mt19937& generator, long& exact) {
+
+    orcs::SearchContext context(problem);
+    for (auto& entry : orcs::tests::base_schedules(problem, context, generator)) {
+
+        // The segment data is loaded as in the local search (see Neighborhood)
+        orcs::DeltaEvaluator& evaluator = context.delta;
+        bool feasible = evaluator.load(entry);
+        context.segments.load(evaluator.base(), feasible);
+
+        for (auto type : orcs::tests::move_types()) {
+            orcs::MoveSpace movements(type, evaluator.base());
+            orcs::FlatSchedule working = evaluator.base();
+
+            for (auto k : orcs::tests::sample(movements.size(), 500, generator)) {
+                orcs::Move move = movements[k];
+
+                double price;
+                bool is_exact = move.price(context.segments, price);
+
+                move.apply(working);
+                double makespan;
+                bool neighbor_feasible = orcs::tests::evaluate(problem, working, context, makespan);
+                move.undo(working);
+
+                if (is_exact) {
+                    ++exact;
+                    orcs::tests::check(neighbor_feasible, "an exact price is given to feasible neighbors only");
+                    orcs::tests::check(orcs::tests::same_makespan(problem, price, makespan),
+                            "an exact price is the makespan of the neighbor");
+                } else if (neighbor_feasible) {
+                    orcs::tests::check(price <= makespan || orcs::tests::same_makespan(problem, price, makespan),
+                            "a price is a lower bound on the makespan of the neighbor");
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Check the prices on the instance without precedence constraints, in which the teams
+ * are independent of each other, so the moves of instances with integer times are
+ * priced exactly.
+ */
+static void test_relaxed_prices(const orcs::Problem& problem, std::mt19937& generator, long& exact) {
+
+    // Instance without precedence constraints
+    orcs::Problem relaxed = problem;
+    for (int j = 0; j <= problem.n; ++j) {
+        relaxed.predecessors[j].clear();
+        relaxed.successors[j].clear();
+    }
+
+    relaxed.predecessors_csr = orcs::Adjacency(relaxed.predecessors);
+    relaxed.successors_csr = orcs::Adjacency(relaxed.successors);
+    relaxed.precedence_matrix = orcs::BitMatrix(problem.n + 1);
+    relaxed.precedence_matrix_transposed = orcs::BitMatrix(problem.n + 1);
+
+    test_prices(relaxed, generator, exact);
+}
+
+int main(int argc, char** argv) {
+
+    std::string directory = (argc > 1 ? argv[1] : "instances/benchmark");
+    std::mt19937 generator(0);
+
+    long exact = 0;
+    for (auto& path : orcs::tests::instances(directory)) {
+        for (bool fractional : {false, true}) {
+            orcs::Problem problem(path);
+            if (fractional) {
+                orcs::tests::make_fractional(problem);
+            }
+
+            test_prices(problem, generator, exact);
+            test_relaxed_prices(problem, generator, exact);
+        }
+    }
+
+    orcs::tests::check(exact > 0, "some moves are priced exactly");
+    return orcs::tests::report("test_segment_data");
+}
@@ -0,0 +1,175 @@
+#ifndef MANEUVERS_SCHEDULING_TESTS_TEST_UTILS_H
+#define MANEUVERS_SCHEDULING_TESTS_TEST_UTILS_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "flat_schedule.h"
+#include "heur_greedy.h"
+#include "move.h"
+#include "neighborhood.h"
+#include "problem.h"
+#include "search_context.h"
+#include "utils.h"
+
+
+namespace orcs {
+
+    namespace tests {
+
+        // Number of checks performed and failed by the test
+        inline long checks = 0;
+        inline long failures = 0;
+
+        /**
+         * Check a condition, reporting it if it does not hold.
+         *
+         * @param   condition
+         *          The condition.
+         * @param   message
+         *          Description of the check.
+         */
+        inline void check(bool condition, const std::string& message) {
+            ++checks;
+            if (!condition) {
+                ++failures;
+                if (failures <= 20) {
+                    std::printf("FAILED: %s\n", message.c_str());
+                }
+            }
+        }
+
+        /**
+         * Print the summary of the checks and return the exit status of the test.
+         */
+        inline int report(const std::string& name) {
+            std::printf("%s: %ld checks, %ld failures\n", name.c_str(), checks, failures);
+            return (failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+        }
+
+        /**
+         * Return the paths of the instances used by the tests (with 10, 20 and 60
+         * switches), given the directory of the benchmark instances.
+         */
+        inline std::vector<std::string> instances(const std::string& directory) {
+            std::vector<std::string> paths;
+            for (auto name : {"10_2_3_10_G", "20_4_3_10_I", "20_6_5_10_S", "60_10_5_10_S"}) {
+                paths.push_back(directory + "/" + name + ".txt");
+            }
+
+            return paths;
+        }
+
+        /**
+         * Turn the times of an instance into fractional values, so the evaluation in
+         * double (instead of exact integer arithmetic) is tested as well.
+         */
+        inline void make_fractional(Problem& problem) {
+            problem.integer_times = false;
+            for (int j = 1; j <= problem.n; ++j) {
+                problem.p[j] = problem.p[j] * 1.25 + 0.125;
+            }
+
+            for (auto& value : problem.travel_times) {
+                value = value * 1.25 + 0.125;
+            }
+        }
+
+        /**
+         * Return the base schedules of the tests: the greedy solution and schedules
+         * obtained from it by random (feasible) moves.
+         */
+        inline std::vector<std::tuple<Schedule, double>> base_schedules(const Problem& problem,
+                SearchContext& context, std::mt19937& generator) {
+
+            Greedy greedy;
+            std::vector<std::tuple<Schedule, double>> schedules;
+            schedules.push_back(greedy.solve(problem));
+
+            Reassignement reassignment;
+            Swap swap;
+            Neighborhood* neighborhoods[] = {&reassignment, &swap};
+            for (int k = 0; k < 3; ++k) {
+                std::tuple<Schedule, double> entry = schedules.back();
+                for (int pass = 0; pass < 3; ++pass) {
+                    for (auto neighborhood : neighborhoods) {
+                        entry = neighborhood->shake(problem, entry, true, context, generator);
+                    }
+                }
+
+                schedules.push_back(entry);
+            }
+
+            return schedules;
+        }
+
+        /**
+         * Evaluate a (flat) schedule from scratch.
+         *
+         * @param   problem
+         *          The instance of the problem.
+         * @param   schedule
+         *          The schedule to evaluate.
+         * @param   context
+         *          The search context.
+         * @param   makespan
+         *          The makespan of the schedule (infinity, if infeasible).
+         * @return  True if the schedule is feasible, false otherwise.
+         */
+        inline bool evaluate(const Problem& problem, const FlatSchedule& schedule, SearchContext& context,
+                double& makespan) {
+            std::tuple<Schedule, double> entry(schedule.to_schedule(), 0.0);
+            bool feasible = utils::evaluate(problem, entry, context.evaluation);
+            makespan = std::get<double>(entry);
+            return feasible;
+        }
+
+        /**
+         * Check whether two makespans are equal: exactly, if the times of the instance
+         * are integer values, or up to the rounding errors, otherwise.
+         */
+        inline bool same_makespan(const Problem& problem, double first, double second) {
+            return (problem.integer_times ? first == second : utils::is_equal(first, second));
+        }
+
+        /**
+         * Return the indexes of the moves of a move space examined by the tests: all
+         * of them, if there are few, or a random sample, otherwise.
+         */
+        inline std::vector<std::uint64_t> sample(std::uint64_t size, std::uint64_t count,
+                std::mt19937& generator) {
+
+            std::vector<std::uint64_t> indexes;
+            if (size <= count) {
+                for (std::uint64_t k = 0; k < size; ++k) {
+                    indexes.push_back(k);
+                }
+            } else {
+                std::uniform_int_distribution<std::uint64_t> index(0, size - 1);
+                for (std::uint64_t k = 0; k < count; ++k) {
+                    indexes.push_back(index(generator));
+                }
+            }
+
+            return indexes;
+        }
+
+        /**
+         * Types of moves examined by the tests.
+         */
+        inline std::vector<MoveType> move_types() {
+            return {MoveType::SHIFT, MoveType::REASSIGN, MoveType::SWAP, MoveType::PAIR_SWAP,
+                    MoveType::OR_OPT, MoveType::TAIL_EXCHANGE};
+        }
+
+    }
+
+}
+
+
+#endif